@@ -0,0 +1,60 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "api/api_requests_pacer.h"
+
+namespace Api {
+namespace {
+
+constexpr auto kTokensLimit = 30;
+constexpr auto kTokenRefill = crl::time(100);
+
+} // namespace
+
+RequestsPacer::RequestsPacer()
+: _refilled(crl::now())
+, _tokens(kTokensLimit) {
+}
+
+bool RequestsPacer::take(Type type) {
+	auto &counters = _counters[int(type)];
+	refill(crl::now());
+	if (!_tokens) {
+		++counters.postponed;
+		return false;
+	}
+	--_tokens;
+	++counters.sent;
+	return true;
+}
+
+crl::time RequestsPacer::nextTokenIn() const {
+	if (_tokens > 0) {
+		return 0;
+	}
+	const auto passed = crl::now() - _refilled;
+	return std::max(kTokenRefill - passed, crl::time(1));
+}
+
+auto RequestsPacer::counters(Type type) const -> const Counters & {
+	return _counters[int(type)];
+}
+
+void RequestsPacer::refill(crl::time now) {
+	const auto add = (now - _refilled) / kTokenRefill;
+	if (add <= 0) {
+		return;
+	} else if (_tokens + add >= kTokensLimit) {
+		_tokens = kTokensLimit;
+		_refilled = now;
+	} else {
+		_tokens += int(add);
+		_refilled += add * kTokenRefill;
+	}
+}
+
+} // namespace Api
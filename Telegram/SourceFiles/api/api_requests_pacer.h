@@ -0,0 +1,46 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+namespace Api {
+
+// Background per-peer requests (reading history, incrementing views,
+// polling extended media) are fired from timers for every open chat,
+// so with hundreds of channels they come in storms. They all share one
+// token bucket: a caller that can't take a token leaves its request
+// for later and re-arms its timer for nextTokenIn().
+class RequestsPacer final {
+public:
+	enum class Type : uchar {
+		ReadHistory,
+		ViewsIncrement,
+		ExtendedMediaPoll,
+
+		kCount,
+	};
+	struct Counters {
+		int64 sent = 0;
+		int64 postponed = 0;
+	};
+
+	RequestsPacer();
+
+	[[nodiscard]] bool take(Type type);
+	[[nodiscard]] crl::time nextTokenIn() const;
+	[[nodiscard]] const Counters &counters(Type type) const;
+
+private:
+	void refill(crl::time now);
+
+	std::array<Counters, int(Type::kCount)> _counters;
+	crl::time _refilled = 0;
+	int _tokens = 0;
+
+};
+
+} // namespace Api
@@ -427,6 +427,10 @@ void Updates::channelDifferenceDone(
 
 void Updates::feedChannelDifference(
 		const MTPDupdates_channelDifference &data) {
+	auto &changes = session().changes();
+	changes.startBatch();
+	const auto guard = gsl::finally([&] { changes.finishBatch(); });
+
 	session().data().processUsers(data.vusers());
 	session().data().processChats(data.vchats());
 
@@ -593,6 +597,11 @@ void Updates::feedDifference(
 		const MTPVector<MTPMessage> &msgs,
 		const MTPVector<MTPUpdate> &other) {
 	Core::App().checkAutoLock();
+
+	auto &changes = session().changes();
+	changes.startBatch();
+	const auto guard = gsl::finally([&] { changes.finishBatch(); });
+
 	session().data().processUsers(users);
 	session().data().processChats(chats);
 	feedMessageIds(other);
@@ -7,6 +7,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 */
 #include "api/api_views.h"
 
+#include "api/api_requests_pacer.h"
 #include "apiwrap.h"
 #include "data/data_peer.h"
 #include "data/data_peer_id.h"
@@ -75,10 +76,14 @@ void ViewsManager::pollExtendedMedia(not_null<HistoryItem*> item) {
 }
 
 void ViewsManager::viewsIncrement() {
+	auto &pacer = _session->api().requestsPacer();
 	for (auto i = _toIncrement.begin(); i != _toIncrement.cend();) {
 		if (_incrementRequests.contains(i->first)) {
 			++i;
 			continue;
+		} else if (!pacer.take(RequestsPacer::Type::ViewsIncrement)) {
+			_incrementTimer.callOnce(pacer.nextTokenIn());
+			return;
 		}
 
 		QVector<MTPint> ids;
@@ -105,6 +110,7 @@ void ViewsManager::viewsIncrement() {
 
 void ViewsManager::sendPollRequests() {
 	const auto now = crl::now();
+	auto &pacer = _session->api().requestsPacer();
 	auto toRequest = base::flat_map<not_null<PeerData*>, QVector<MTPint>>();
 	auto nearest = crl::time();
 	for (auto &[peer, request] : _pollRequests) {
@@ -112,6 +118,13 @@ void ViewsManager::sendPollRequests() {
 			continue;
 		} else if (request.when <= now) {
 			Assert(request.sent.empty());
+			if (!pacer.take(RequestsPacer::Type::ExtendedMediaPoll)) {
+				const auto when = now + pacer.nextTokenIn();
+				if (!nearest || nearest > when) {
+					nearest = when;
+				}
+				continue;
+			}
 			auto &list = toRequest[peer];
 			const auto count = int(request.ids.size());
 			if (count < kMaxPollPerRequest) {
@@ -72,6 +72,7 @@ class UserPrivacy;
 class InviteLinks;
 class ChatLinks;
 class ViewsManager;
+class RequestsPacer;
 class ConfirmPhone;
 class PeerPhoto;
 class PeerColors;
@@ -400,6 +401,7 @@ public:
 	[[nodiscard]] Api::InviteLinks &inviteLinks();
 	[[nodiscard]] Api::ChatLinks &chatLinks();
 	[[nodiscard]] Api::ViewsManager &views();
+	[[nodiscard]] Api::RequestsPacer &requestsPacer();
 	[[nodiscard]] Api::ConfirmPhone &confirmPhone();
 	[[nodiscard]] Api::PeerPhoto &peerPhoto();
 	[[nodiscard]] Api::Polls &polls();
@@ -731,6 +733,7 @@ private:
 	const std::unique_ptr<Api::UserPrivacy> _userPrivacy;
 	const std::unique_ptr<Api::InviteLinks> _inviteLinks;
 	const std::unique_ptr<Api::ChatLinks> _chatLinks;
+	const std::unique_ptr<Api::RequestsPacer> _requestsPacer;
 	const std::unique_ptr<Api::ViewsManager> _views;
 	const std::unique_ptr<Api::ConfirmPhone> _confirmPhone;
 	const std::unique_ptr<Api::PeerPhoto> _peerPhoto;
@@ -22,6 +22,8 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 
 #include <QtGui/QGuiApplication>
 
+#include <unordered_set>
+
 namespace ChatHelpers {
 namespace {
 
@@ -32,6 +34,7 @@ constexpr auto kKeepNotUsedInputLanguagesCount = 4;
 using namespace Ui::Emoji;
 
 using Result = EmojiKeywords::Result;
+using FoundEmoji = std::unordered_set<EmojiPtr>;
 
 struct LangPackEmoji {
 	EmojiPtr emoji = nullptr;
@@ -41,7 +44,7 @@ struct LangPackEmoji {
 struct LangPackData {
 	int version = 0;
 	int maxKeyLength = 0;
-	std::map<QString, std::vector<LangPackEmoji>> emoji;
+	base::flat_map<QString, std::vector<LangPackEmoji>> emoji;
 };
 
 [[nodiscard]] bool MustAddPostfix(const QString &text) {
@@ -175,30 +178,19 @@ void WriteLocalCache(const QString &id, const LangPackData &data) {
 
 void AppendFoundEmoji(
 		std::vector<Result> &result,
+		FoundEmoji &found,
 		const QString &label,
 		const std::vector<LangPackEmoji> &list) {
-	// It is important that the 'result' won't relocate while inserting.
-	result.reserve(result.size() + list.size());
-	const auto alreadyBegin = begin(result);
-	const auto alreadyEnd = alreadyBegin + result.size();
-
-	auto &&add = ranges::views::all(
-		list
-	) | ranges::views::filter([&](const LangPackEmoji &entry) {
-		const auto i = ranges::find(
-			alreadyBegin,
-			alreadyEnd,
-			entry.emoji,
-			&Result::emoji);
-		return (i == alreadyEnd);
-	}) | ranges::views::transform([&](const LangPackEmoji &entry) {
-		return Result{ entry.emoji, label, entry.text };
-	});
-	result.insert(end(result), add.begin(), add.end());
+	for (const auto &entry : list) {
+		if (found.emplace(entry.emoji).second) {
+			result.push_back({ entry.emoji, label, entry.text });
+		}
+	}
 }
 
 void AppendLegacySuggestions(
 		std::vector<Result> &result,
+		FoundEmoji &found,
 		const QString &query) {
 	const auto badSuggestionChar = [](QChar ch) {
 		return (ch < 'a' || ch > 'z')
@@ -213,32 +205,16 @@ void AppendLegacySuggestions(
 	}
 
 	const auto suggestions = GetSuggestions(QStringToUTF16(query));
-
-	// It is important that the 'result' won't relocate while inserting.
-	result.reserve(result.size() + suggestions.size());
-	const auto alreadyBegin = begin(result);
-	const auto alreadyEnd = alreadyBegin + result.size();
-
-	auto &&add = ranges::views::all(
-		suggestions
-	) | ranges::views::transform([](const Suggestion &suggestion) {
-		return Result{
-			Find(QStringFromUTF16(suggestion.emoji())),
-			QStringFromUTF16(suggestion.label()),
-			QStringFromUTF16(suggestion.replacement())
-		};
-	}) | ranges::views::filter([&](const Result &entry) {
-		const auto i = entry.emoji
-			? ranges::find(
-				alreadyBegin,
-				alreadyEnd,
-				entry.emoji,
-				&Result::emoji)
-			: alreadyEnd;
-		return (entry.emoji != nullptr)
-			&& (i == alreadyEnd);
-	});
-	result.insert(end(result), add.begin(), add.end());
+	for (const auto &suggestion : suggestions) {
+		const auto emoji = Find(QStringFromUTF16(suggestion.emoji()));
+		if (emoji && found.emplace(emoji).second) {
+			result.push_back({
+				emoji,
+				QStringFromUTF16(suggestion.label()),
+				QStringFromUTF16(suggestion.replacement())
+			});
+		}
+	}
 }
 
 void ApplyDifference(
@@ -246,13 +222,19 @@ void ApplyDifference(
 		const QVector<MTPEmojiKeyword> &keywords,
 		int version) {
 	data.version = version;
+
+	// The first full load comes here with thousands of keywords in the
+	// server order, inserting each of them to the flat map would shift
+	// the rest, so the new keywords are merged in once in the end.
+	auto added = std::map<QString, std::vector<LangPackEmoji>>();
 	for (const auto &keyword : keywords) {
 		keyword.match([&](const MTPDemojiKeyword &keyword) {
 			const auto word = NormalizeKey(qs(keyword.vkeyword()));
 			if (word.isEmpty()) {
 				return;
 			}
-			auto &list = data.emoji[word];
+			const auto i = data.emoji.find(word);
+			auto &list = (i != end(data.emoji)) ? i->second : added[word];
 			auto &&emoji = ranges::views::all(
 				keyword.vemoticons().v
 			) | ranges::views::transform([](const MTPstring &string) {
@@ -276,21 +258,43 @@ void ApplyDifference(
 			if (word.isEmpty()) {
 				return;
 			}
-			const auto i = data.emoji.find(word);
-			if (i == end(data.emoji)) {
-				return;
-			}
-			auto &list = i->second;
-			for (const auto &emoji : keyword.vemoticons().v) {
-				list.erase(
-					ranges::remove(list, qs(emoji), &LangPackEmoji::text),
-					end(list));
-			}
-			if (list.empty()) {
-				data.emoji.erase(i);
-			}
+			const auto removeFrom = [&](auto &map) {
+				const auto i = map.find(word);
+				if (i == end(map)) {
+					return;
+				}
+				auto &list = i->second;
+				for (const auto &emoji : keyword.vemoticons().v) {
+					list.erase(
+						ranges::remove(list, qs(emoji), &LangPackEmoji::text),
+						end(list));
+				}
+				if (list.empty()) {
+					map.erase(i);
+				}
+			};
+			removeFrom(data.emoji);
+			removeFrom(added);
 		});
 	}
+	if (!added.empty()) {
+		// Both are sorted and don't intersect, so emplacing them in the
+		// ascending order only appends to the end of the flat map.
+		auto merged = base::flat_map<QString, std::vector<LangPackEmoji>>();
+		auto i = begin(data.emoji);
+		auto j = begin(added);
+		while (i != end(data.emoji) || j != end(added)) {
+			if (j == end(added)
+				|| (i != end(data.emoji) && i->first < j->first)) {
+				merged.emplace(i->first, std::move(i->second));
+				++i;
+			} else {
+				merged.emplace(j->first, std::move(j->second));
+				++j;
+			}
+		}
+		data.emoji = std::move(merged);
+	}
 	if (data.emoji.empty()) {
 		data.maxKeyLength = 0;
 	} else {
@@ -319,7 +323,9 @@ public:
 	void refresh();
 	void apiChanged();
 
-	[[nodiscard]] std::vector<Result> query(
+	void query(
+		std::vector<Result> &result,
+		FoundEmoji &found,
 		const QString &normalized,
 		bool exact) const;
 	[[nodiscard]] int maxQueryLength() const;
@@ -470,13 +476,15 @@ void EmojiKeywords::LangPack::apiChanged() {
 	refresh();
 }
 
-std::vector<Result> EmojiKeywords::LangPack::query(
+void EmojiKeywords::LangPack::query(
+		std::vector<Result> &result,
+		FoundEmoji &found,
 		const QString &normalized,
 		bool exact) const {
 	if (normalized.size() > _data.maxKeyLength
 		|| _data.emoji.empty()
 		|| (exact && SkipExactKeyword(_id, normalized))) {
-		return {};
+		return;
 	}
 
 	const auto from = _data.emoji.lower_bound(normalized);
@@ -488,11 +496,9 @@ std::vector<Result> EmojiKeywords::LangPack::query(
 		return exact ? (key == normalized) : key.startsWith(normalized);
 	});
 
-	auto result = std::vector<Result>();
 	for (const auto &[key, list] : chosen) {
-		AppendFoundEmoji(result, key, list);
+		AppendFoundEmoji(result, found, key, list);
 	}
-	return result;
 }
 
 int EmojiKeywords::LangPack::maxQueryLength() const {
@@ -613,30 +619,12 @@ std::vector<Result> EmojiKeywords::query(
 		return {};
 	}
 	auto result = std::vector<Result>();
+	auto found = FoundEmoji();
 	for (const auto &[language, item] : _data) {
-		const auto list = item->query(normalized, exact);
-
-		// It is important that the 'result' won't relocate while inserting.
-		result.reserve(result.size() + list.size());
-		const auto alreadyBegin = begin(result);
-		const auto alreadyEnd = alreadyBegin + result.size();
-
-		auto &&add = ranges::views::all(
-			list
-		) | ranges::views::filter([&](Result entry) {
-			// In each item->query() result the list has no duplicates.
-			// So we need to check only for duplicates between queries.
-			const auto i = ranges::find(
-				alreadyBegin,
-				alreadyEnd,
-				entry.emoji,
-				&Result::emoji);
-			return (i == alreadyEnd);
-		});
-		result.insert(end(result), add.begin(), add.end());
+		item->query(result, found, normalized, exact);
 	}
 	if (!exact) {
-		AppendLegacySuggestions(result, query);
+		AppendLegacySuggestions(result, found, query);
 	}
 	return result;
 }
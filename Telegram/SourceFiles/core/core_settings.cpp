@@ -262,7 +262,7 @@ QByteArray Settings::serialize() const {
 			<< qint32(_countUnreadMessages ? 1 : 0)
 			<< qint32(1) // legacy exe launch warning
 			<< qint32(_notifyAboutPinned.current() ? 1 : 0)
-			<< qint32(_loopAnimatedStickers ? 1 : 0)
+			<< qint32(_loopAnimatedStickers.current() ? 1 : 0)
 			<< qint32(_largeEmoji.current() ? 1 : 0)
 			<< qint32(_replaceEmoji.current() ? 1 : 0)
 			<< qint32(_suggestEmoji ? 1 : 0)
@@ -423,7 +423,7 @@ void Settings::addFromSerialized(const QByteArray &serialized) {
 	std::optional<QString> noWarningExtensions;
 	qint32 legacyExeLaunchWarning = 1;
 	qint32 notifyAboutPinned = _notifyAboutPinned.current() ? 1 : 0;
-	qint32 loopAnimatedStickers = _loopAnimatedStickers ? 1 : 0;
+	qint32 loopAnimatedStickers = _loopAnimatedStickers.current() ? 1 : 0;
 	qint32 largeEmoji = _largeEmoji.current() ? 1 : 0;
 	qint32 replaceEmoji = _replaceEmoji.current() ? 1 : 0;
 	qint32 suggestEmoji = _suggestEmoji ? 1 : 0;
@@ -413,7 +413,10 @@ public:
 		_ipRevealWarning = warning;
 	}
 	[[nodiscard]] bool loopAnimatedStickers() const {
-		return _loopAnimatedStickers;
+		return _loopAnimatedStickers.current();
+	}
+	[[nodiscard]] rpl::producer<bool> loopAnimatedStickersChanges() const {
+		return _loopAnimatedStickers.changes();
 	}
 	void setLoopAnimatedStickers(bool value) {
 		_loopAnimatedStickers = value;
@@ -981,7 +984,7 @@ private:
 	base::flat_map<QString, QString> _soundOverrides;
 	base::flat_set<QString> _noWarningExtensions;
 	bool _ipRevealWarning = true;
-	bool _loopAnimatedStickers = true;
+	rpl::variable<bool> _loopAnimatedStickers = true;
 	rpl::variable<bool> _largeEmoji = true;
 	rpl::variable<bool> _replaceEmoji = true;
 	rpl::variable<Ui::InstantReplaces> _instantReplaces;
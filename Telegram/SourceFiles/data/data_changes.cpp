@@ -326,4 +326,25 @@ void Changes::sendNotifications() {
 	_storyChanges.sendNotifications();
 }
 
+void Changes::startBatch() {
+	++_batchDepth;
+}
+
+void Changes::finishBatch() {
+	Expects(_batchDepth > 0);
+
+	if (!--_batchDepth) {
+		sendNotifications();
+		_batchFinished.fire({});
+	}
+}
+
+bool Changes::batched() const {
+	return (_batchDepth > 0);
+}
+
+rpl::producer<> Changes::batchFinished() const {
+	return _batchFinished.events();
+}
+
 } // namespace Data
@@ -345,6 +345,14 @@ public:
 
 	void sendNotifications();
 
+	// Between startBatch() and finishBatch() the listeners that aggregate
+	// many entries (like unread counters) wait for batchFinished() instead
+	// of recomputing on every single change.
+	void startBatch();
+	void finishBatch();
+	[[nodiscard]] bool batched() const;
+	[[nodiscard]] rpl::producer<> batchFinished() const;
+
 private:
 	template <typename DataType, typename UpdateType>
 	class Manager final {
@@ -395,6 +403,8 @@ private:
 	Manager<Dialogs::Entry, EntryUpdate> _entryChanges;
 	Manager<Story, StoryUpdate> _storyChanges;
 
+	rpl::event_stream<> _batchFinished;
+	int _batchDepth = 0;
 	bool _notify = false;
 
 };
@@ -43,13 +43,8 @@ constexpr auto kClearLoadingTimeout = 5 * crl::time(1000);
 constexpr auto kMaxFileSize = 4000 * int64(1024 * 1024);
 constexpr auto kMaxResolvePerAttempt = 100;
 
-constexpr auto ByItem = [](const auto &entry) {
-	if constexpr (std::is_same_v<decltype(entry), const DownloadingId&>) {
-		return entry.object.item;
-	} else {
-		const auto resolved = entry.object.get();
-		return resolved ? resolved->item.get() : nullptr;
-	}
+constexpr auto ByItem = [](const DownloadingId &entry) {
+	return entry.object.item;
 };
 
 constexpr auto ByDocument = [](const auto &entry) {
@@ -309,17 +304,18 @@ void DownloadManager::addLoaded(
 	const auto id = object.document
 		? DownloadId{ object.document->id, DownloadType::Document }
 		: DownloadId{ object.photo->id, DownloadType::Photo };
-	data.downloaded.push_back({
-		.download = id,
-		.started = started,
-		.path = path,
-		.size = size,
-		.itemId = item->fullId(),
-		.peerAccessHash = PeerAccessHash(item->history()->peer),
-		.object = std::make_unique<DownloadObject>(object),
-	});
-	_loaded.emplace(item);
-	_loadedAdded.fire(&data.downloaded.back());
+	const auto entry = data.downloaded.emplace_back(
+		std::make_unique<DownloadedId>(DownloadedId{
+			.download = id,
+			.started = started,
+			.path = path,
+			.size = size,
+			.itemId = item->fullId(),
+			.peerAccessHash = PeerAccessHash(item->history()->peer),
+			.object = std::make_unique<DownloadObject>(object),
+		})).get();
+	_loaded.emplace(item, entry);
+	_loadedAdded.fire(entry);
 
 	writePostponed(&item->history()->session());
 
@@ -377,15 +373,20 @@ void DownloadManager::deleteFiles(const std::vector<GlobalMsgId> &ids) {
 				cancel(data, j);
 			}
 
-			const auto k = ranges::find(data.downloaded, item, ByItem);
-			if (k != end(data.downloaded)) {
-				const auto document = k->object->document;
-				descriptor.files.emplace(k->path, DocumentDescriptor{
+			const auto loaded = _loaded.find(item);
+			if (loaded != end(_loaded)) {
+				const auto k = ranges::find(
+					data.downloaded,
+					loaded->second.get(),
+					[](const auto &entry) { return entry.get(); });
+				Assert(k != end(data.downloaded));
+				const auto document = (*k)->object->document;
+				descriptor.files.emplace((*k)->path, DocumentDescriptor{
 					.sessionUniqueId = id.sessionUniqueId,
 					.documentId = document ? document->id : DocumentId(),
 					.itemId = id.itemId,
 				});
-				_loaded.remove(item);
+				_loaded.erase(loaded);
 				_generated.remove(item);
 				if (document) {
 					_generatedDocuments.remove(document);
@@ -412,19 +413,19 @@ void DownloadManager::deleteAll() {
 		while (!data.downloading.empty()) {
 			cancel(data, data.downloading.end() - 1);
 		}
-		for (auto &id : base::take(data.downloaded)) {
-			const auto object = id.object.get();
+		for (const auto &id : base::take(data.downloaded)) {
+			const auto object = id->object.get();
 			const auto document = object ? object->document : nullptr;
-			descriptor.files.emplace(id.path, DocumentDescriptor{
+			descriptor.files.emplace(id->path, DocumentDescriptor{
 				.sessionUniqueId = sessionUniqueId,
 				.documentId = document ? document->id : DocumentId(),
-				.itemId = id.itemId,
+				.itemId = id->itemId,
 			});
 			if (document) {
 				_generatedDocuments.remove(document);
 			}
 			if (const auto item = object ? object->item.get() : nullptr) {
-				_loaded.remove(item);
+				_loaded.erase(item);
 				_generated.remove(item);
 				_loadedRemoved.fire_copy(item);
 			}
@@ -463,7 +464,7 @@ void DownloadManager::finishFilesDelete(DeleteFilesDescriptor &&descriptor) {
 bool DownloadManager::loadedHasNonCloudFile() const {
 	for (const auto &[session, data] : _sessions) {
 		for (const auto &id : data.downloaded) {
-			if (const auto object = id.object.get()) {
+			if (const auto object = id->object.get()) {
 				if (!object->item->isHistoryEntry()) {
 					return true;
 				}
@@ -610,10 +611,10 @@ auto DownloadManager::loadedList()
 	) | ranges::views::transform([=](const auto &pair) {
 		return ranges::views::all(
 			pair.second.downloaded
-		) | ranges::views::filter([](const DownloadedId &id) {
-			return (id.object != nullptr);
-		}) | ranges::views::transform([](const DownloadedId &id) {
-			return &id;
+		) | ranges::views::filter([](const auto &id) {
+			return (id->object != nullptr);
+		}) | ranges::views::transform([](const auto &id) {
+			return static_cast<const DownloadedId*>(id.get());
 		});
 	}) | ranges::views::join;
 }
@@ -642,7 +643,7 @@ void DownloadManager::resolve(
 	auto last = begin(data.downloaded);
 	auto from = last + (data.resolveNeeded - data.resolveSentTotal);
 	for (auto i = from; i != last;) {
-		auto &id = *--i;
+		auto &id = **--i;
 		const auto msgId = id.itemId.msg;
 		const auto info = QFileInfo(id.path);
 		if (!info.exists() || info.size() != id.size) {
@@ -704,29 +705,30 @@ void DownloadManager::resolveRequestsFinished(
 	auto &owner = session->data();
 	for (; data.resolveSentTotal > 0; --data.resolveSentTotal) {
 		const auto i = begin(data.downloaded) + (--data.resolveNeeded);
-		if (i->path.isEmpty()) {
+		const auto entry = i->get();
+		if (entry->path.isEmpty()) {
 			data.downloaded.erase(i);
 			continue;
 		}
-		const auto item = owner.message(i->itemId);
+		const auto item = owner.message(entry->itemId);
 		const auto media = item ? item->media() : nullptr;
 		const auto document = media ? media->document() : nullptr;
 		const auto photo = media ? media->photo() : nullptr;
-		if (i->download.type == DownloadType::Document
-			&& (!document || document->id != i->download.objectId)) {
-			generateEntry(session, *i);
-		} else if (i->download.type == DownloadType::Photo
-			&& (!photo || photo->id != i->download.objectId)) {
-			generateEntry(session, *i);
+		if (entry->download.type == DownloadType::Document
+			&& (!document || document->id != entry->download.objectId)) {
+			generateEntry(session, *entry);
+		} else if (entry->download.type == DownloadType::Photo
+			&& (!photo || photo->id != entry->download.objectId)) {
+			generateEntry(session, *entry);
 		} else {
-			i->object = std::make_unique<DownloadObject>(DownloadObject{
+			entry->object = std::make_unique<DownloadObject>(DownloadObject{
 				.item = item,
 				.document = document,
 				.photo = photo,
 			});
-			_loaded.emplace(item);
+			_loaded.emplace(item, entry);
 		}
-		_loadedAdded.fire(&*i);
+		_loadedAdded.fire(entry);
 	}
 	crl::on_main(session, [=] {
 		resolve(session, sessionData(session));
@@ -775,7 +777,7 @@ void DownloadManager::generateEntry(
 		.item = generateFakeItem(document),
 		.document = document,
 	});
-	_loaded.emplace(id.object->item);
+	_loaded.emplace(id.object->item, &id);
 }
 
 auto DownloadManager::loadedAdded() const
@@ -824,16 +826,14 @@ void DownloadManager::cancel(
 }
 
 void DownloadManager::changed(not_null<const HistoryItem*> item) {
-	if (_loaded.contains(item)) {
-		auto &data = sessionData(item);
-		const auto i = ranges::find(data.downloaded, item.get(), ByItem);
-		Assert(i != end(data.downloaded));
-
+	if (const auto i = _loaded.find(item); i != end(_loaded)) {
+		const auto entry = i->second;
 		const auto media = item->media();
 		const auto photo = media ? media->photo() : nullptr;
 		const auto document = media ? media->document() : nullptr;
-		if (i->object->photo != photo || i->object->document != document) {
-			detach(*i);
+		if (entry->object->photo != photo
+			|| entry->object->document != document) {
+			detach(*entry);
 		}
 	}
 	if (_loading.contains(item) || _loadingDone.contains(item)) {
@@ -842,11 +842,8 @@ void DownloadManager::changed(not_null<const HistoryItem*> item) {
 }
 
 void DownloadManager::removed(not_null<const HistoryItem*> item) {
-	if (_loaded.contains(item)) {
-		auto &data = sessionData(item);
-		const auto i = ranges::find(data.downloaded, item.get(), ByItem);
-		Assert(i != end(data.downloaded));
-		detach(*i);
+	if (const auto i = _loaded.find(item); i != end(_loaded)) {
+		detach(*i->second);
 	}
 	if (_loading.contains(item) || _loadingDone.contains(item)) {
 		auto &data = sessionData(item);
@@ -907,8 +904,8 @@ void DownloadManager::detach(DownloadedId &id) {
 	// Maybe generate new document?
 	const auto was = id.object->item;
 	const auto now = regenerateItem(*id.object);
-	_loaded.remove(was);
-	_loaded.emplace(now);
+	_loaded.erase(was);
+	_loaded.emplace(now, &id);
 	id.object->item = now;
 
 	_loadedRemoved.fire_copy(was);
@@ -966,7 +963,7 @@ Fn<std::optional<QByteArray>()> DownloadManager::serializator(
 		auto size = sizeof(qint32) // count
 			+ count * constant;
 		for (const auto &id : data.downloaded) {
-			size += Serialize::stringSize(id.path);
+			size += Serialize::stringSize(id->path);
 		}
 		result.reserve(size);
 
@@ -975,15 +972,15 @@ Fn<std::optional<QByteArray>()> DownloadManager::serializator(
 		stream << qint32(count);
 		for (const auto &id : data.downloaded) {
 			stream
-				<< quint64(id.download.objectId)
-				<< qint32(id.download.type)
-				<< qint64(id.started)
+				<< quint64(id->download.objectId)
+				<< qint32(id->download.type)
+				<< qint64(id->started)
 				// FileSize: Right now any file size fits 32 bit.
-				<< quint32(id.size)
-				<< quint64(id.itemId.peer.value)
-				<< qint64(id.itemId.msg.bare)
-				<< quint64(id.peerAccessHash)
-				<< id.path;
+				<< quint32(id->size)
+				<< quint64(id->itemId.peer.value)
+				<< qint64(id->itemId.msg.bare)
+				<< quint64(id->peerAccessHash)
+				<< id->path;
 		}
 		stream.device()->close();
 
@@ -991,8 +988,9 @@ Fn<std::optional<QByteArray>()> DownloadManager::serializator(
 	};
 }
 
-std::vector<DownloadedId> DownloadManager::deserialize(
-		not_null<Main::Session*> session) const {
+auto DownloadManager::deserialize(
+		not_null<Main::Session*> session) const
+-> std::vector<std::unique_ptr<DownloadedId>> {
 	const auto serialized = session->account().local().downloadsSerialized();
 	if (serialized.isEmpty()) {
 		return {};
@@ -1006,7 +1004,7 @@ std::vector<DownloadedId> DownloadManager::deserialize(
 	if (stream.status() != QDataStream::Ok || count <= 0 || count > 99'999) {
 		return {};
 	}
-	auto result = std::vector<DownloadedId>();
+	auto result = std::vector<std::unique_ptr<DownloadedId>>();
 	result.reserve(count);
 	for (auto i = 0; i != count; ++i) {
 		auto downloadObjectId = quint64();
@@ -1036,7 +1034,7 @@ std::vector<DownloadedId> DownloadManager::deserialize(
 				&& downloadType != DownloadType::Photo)) {
 			return {};
 		}
-		result.push_back({
+		result.push_back(std::make_unique<DownloadedId>(DownloadedId{
 			.download = {
 				.objectId = downloadObjectId,
 				.type = downloadType,
@@ -1046,7 +1044,7 @@ std::vector<DownloadedId> DownloadManager::deserialize(
 			.size = int64(size),
 			.itemId = { PeerId(itemIdPeer), MsgId(itemIdMsg) },
 			.peerAccessHash = peerAccessHash,
-		});
+		}));
 	}
 	return result;
 }
@@ -1056,9 +1054,9 @@ void DownloadManager::untrack(not_null<Main::Session*> session) {
 	Assert(i != end(_sessions));
 
 	for (const auto &entry : i->second.downloaded) {
-		if (const auto resolved = entry.object.get()) {
+		if (const auto resolved = entry->object.get()) {
 			const auto item = resolved->item;
-			_loaded.remove(item);
+			_loaded.erase(item);
 			_generated.remove(item);
 			if (const auto document = resolved->document) {
 				_generatedDocuments.remove(document);
@@ -120,7 +120,7 @@ public:
 private:
 	struct DeleteFilesDescriptor;
 	struct SessionData {
-		std::vector<DownloadedId> downloaded;
+		std::vector<std::unique_ptr<DownloadedId>> downloaded;
 		std::vector<DownloadingId> downloading;
 		int resolveNeeded = 0;
 		int resolveSentRequests = 0;
@@ -176,14 +176,16 @@ private:
 	void writePostponed(not_null<Main::Session*> session);
 	[[nodiscard]] Fn<std::optional<QByteArray>()> serializator(
 		not_null<Main::Session*> session) const;
-	[[nodiscard]] std::vector<DownloadedId> deserialize(
+	[[nodiscard]] std::vector<std::unique_ptr<DownloadedId>> deserialize(
 		not_null<Main::Session*> session) const;
 
 	base::flat_map<not_null<Main::Session*>, SessionData> _sessions;
 	base::flat_set<not_null<const HistoryItem*>> _loading;
 	base::flat_set<not_null<DocumentData*>> _loadingDocuments;
 	base::flat_set<not_null<const HistoryItem*>> _loadingDone;
-	base::flat_set<not_null<const HistoryItem*>> _loaded;
+	std::unordered_map<
+		not_null<const HistoryItem*>,
+		not_null<DownloadedId*>> _loaded;
 	base::flat_set<not_null<HistoryItem*>> _generated;
 	base::flat_set<not_null<DocumentData*>> _generatedDocuments;
 
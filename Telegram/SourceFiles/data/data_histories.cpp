@@ -7,6 +7,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 */
 #include "data/data_histories.h"
 
+#include "api/api_requests_pacer.h"
 #include "api/api_text_entities.h"
 #include "data/business/data_shortcut_messages.h"
 #include "data/components/scheduled_messages.h"
@@ -571,12 +572,21 @@ void Histories::sendReadRequests() {
 		return;
 	}
 	const auto now = crl::now();
+	auto &pacer = session().api().requestsPacer();
 	auto next = std::optional<crl::time>();
 	for (auto &[history, state] : _states) {
 		if (!state.willReadTill) {
 			DEBUG_LOG(("Reading: skipping zero till."));
 			continue;
 		} else if (state.willReadWhen <= now) {
+			if (!pacer.take(Api::RequestsPacer::Type::ReadHistory)) {
+				DEBUG_LOG(("Reading: postponed by requests pacer."));
+				const auto when = now + pacer.nextTokenIn();
+				if (!next || *next > when) {
+					next = when;
+				}
+				continue;
+			}
 			DEBUG_LOG(("Reading: sending with till %1."
 				).arg(state.willReadTill.bare));
 			sendReadRequest(history, state);
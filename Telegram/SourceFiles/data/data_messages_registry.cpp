@@ -0,0 +1,113 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "data/data_messages_registry.h"
+
+namespace Data {
+namespace {
+
+constexpr auto kMinCapacity = 64;
+
+} // namespace
+
+HistoryItem *MessagesRegistry::find(FullMsgId id) const {
+	if (!_size) {
+		return nullptr;
+	}
+	return _entries[lookup(id)].item;
+}
+
+bool MessagesRegistry::emplace(FullMsgId id, not_null<HistoryItem*> item) {
+	// Keep the load factor below one half.
+	if ((_size + 1) * 2 > int(_entries.size())) {
+		rehash(std::max(int(_entries.size()) * 2, kMinCapacity));
+	}
+	auto &entry = _entries[lookup(id)];
+	if (entry.item) {
+		return false;
+	}
+	entry.id = id;
+	entry.item = item;
+	++_size;
+	return true;
+}
+
+bool MessagesRegistry::erase(FullMsgId id) {
+	if (!_size) {
+		return false;
+	}
+	auto index = lookup(id);
+	if (!_entries[index].item) {
+		return false;
+	}
+
+	// Backward shift deletion, so that we don't need tombstones.
+	const auto mask = int(_entries.size()) - 1;
+	for (auto next = (index + 1) & mask
+		; _entries[next].item
+		; next = (next + 1) & mask) {
+		const auto desired = int(Hash(_entries[next].id) & mask);
+		const auto stays = (index <= next)
+			? (index < desired && desired <= next)
+			: (index < desired || desired <= next);
+		if (!stays) {
+			_entries[index] = _entries[next];
+			index = next;
+		}
+	}
+	_entries[index] = Entry();
+	--_size;
+	return true;
+}
+
+void MessagesRegistry::clear() {
+	_entries = std::vector<Entry>();
+	_size = 0;
+}
+
+int MessagesRegistry::size() const {
+	return _size;
+}
+
+bool MessagesRegistry::empty() const {
+	return !_size;
+}
+
+uint64 MessagesRegistry::Hash(FullMsgId id) {
+	// Peer ids and message ids are both dense, so mix them well.
+	auto result = id.peer.value * 0x9E3779B97F4A7C15ULL
+		^ uint64(id.msg.bare);
+	result ^= result >> 33;
+	result *= 0xFF51AFD7ED558CCDULL;
+	result ^= result >> 33;
+	return result;
+}
+
+int MessagesRegistry::lookup(FullMsgId id) const {
+	Expects(!_entries.empty());
+
+	const auto mask = int(_entries.size()) - 1;
+	for (auto index = int(Hash(id) & mask);; index = (index + 1) & mask) {
+		const auto &entry = _entries[index];
+		if (!entry.item || entry.id == id) {
+			return index;
+		}
+	}
+}
+
+void MessagesRegistry::rehash(int capacity) {
+	Expects(!(capacity & (capacity - 1)));
+
+	auto was = std::exchange(_entries, std::vector<Entry>(capacity));
+	for (const auto &entry : was) {
+		if (entry.item) {
+			_entries[lookup(entry.id)] = entry;
+		}
+	}
+}
+
+} // namespace Data
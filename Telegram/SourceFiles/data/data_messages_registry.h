@@ -0,0 +1,44 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+class HistoryItem;
+
+namespace Data {
+
+// Open addressing (linear probing) table of messages by their full id.
+// Keeps all the entries in one flat array, so lookups don't chase
+// pointers through per-peer maps and there are no per-node allocations.
+class MessagesRegistry final {
+public:
+	[[nodiscard]] HistoryItem *find(FullMsgId id) const;
+
+	// Returns false if there already is a message with such id.
+	bool emplace(FullMsgId id, not_null<HistoryItem*> item);
+	bool erase(FullMsgId id);
+	void clear();
+
+	[[nodiscard]] int size() const;
+	[[nodiscard]] bool empty() const;
+
+private:
+	struct Entry {
+		FullMsgId id;
+		HistoryItem *item = nullptr;
+	};
+
+	[[nodiscard]] static uint64 Hash(FullMsgId id);
+	[[nodiscard]] int lookup(FullMsgId id) const;
+	void rehash(int capacity);
+
+	std::vector<Entry> _entries;
+	int _size = 0;
+
+};
+
+} // namespace Data
@@ -289,7 +289,7 @@ Session::Session(not_null<Main::Session*> session)
 	setupPeerNameViewer();
 	setupUserIsContactViewer();
 
-	_chatsList.unreadStateChanges(
+	_chatsList.unreadStateChangesBatched(
 	) | rpl::start_with_next([=] {
 		notifyUnreadBadgeChanged();
 	}, _lifetime);
@@ -399,8 +399,8 @@ void Session::clear() {
 	_session->scheduledMessages().clear();
 	_session->sponsoredMessages().clear();
 	_dependentMessages.clear();
-	base::take(_messages);
-	base::take(_nonChannelMessages);
+	_messages.clear();
+	_nonChannelMessages.clear();
 	_messageByRandomId.clear();
 	_sentMessagesData.clear();
 	cSetRecentInlineBots(RecentInlineBots());
@@ -1649,23 +1649,20 @@ rpl::producer<not_null<HistoryItem*>> Session::newItemAdded() const {
 }
 
 HistoryItem *Session::changeMessageId(PeerId peerId, MsgId wasId, MsgId nowId) {
-	const auto list = messagesListForInsert(peerId);
-	const auto i = list->find(wasId);
-	if (i == list->end()) {
+	const auto item = _messages.find({ peerId, wasId });
+	if (!item) {
 		return nullptr;
 	}
-	const auto item = i->second;
-	list->erase(i);
-	const auto &[j, ok] = list->emplace(nowId, item);
+	_messages.erase({ peerId, wasId });
+	const auto ok = _messages.emplace({ peerId, nowId }, item);
 
 	if (!peerIsChannel(peerId)) {
 		if (IsServerMsgId(wasId)) {
-			const auto k = _nonChannelMessages.find(wasId);
-			Assert(k != end(_nonChannelMessages));
-			_nonChannelMessages.erase(k);
+			const auto erased = _nonChannelMessages.erase({ PeerId(), wasId });
+			Assert(erased);
 		}
 		if (IsServerMsgId(nowId)) {
-			_nonChannelMessages.emplace(nowId, item);
+			_nonChannelMessages.emplace({ PeerId(), nowId }, item);
 		}
 	}
 
@@ -2382,29 +2379,17 @@ void Session::processExistingMessages(
 	});
 }
 
-const Session::Messages *Session::messagesList(PeerId peerId) const {
-	const auto i = _messages.find(peerId);
-	return (i != end(_messages)) ? &i->second : nullptr;
-}
-
-auto Session::messagesListForInsert(PeerId peerId)
--> not_null<Messages*> {
-	return &_messages[peerId];
-}
-
 void Session::registerMessage(not_null<HistoryItem*> item) {
 	const auto peerId = item->history()->peer->id;
-	const auto list = messagesListForInsert(peerId);
 	const auto itemId = item->id;
-	const auto i = list->find(itemId);
-	if (i != list->end()) {
+	if (const auto existing = _messages.find({ peerId, itemId })) {
 		LOG(("App Error: Trying to re-registerMessage()."));
-		i->second->destroy();
+		existing->destroy();
 	}
-	list->emplace(itemId, item);
+	_messages.emplace({ peerId, itemId }, item);
 
 	if (!peerIsChannel(peerId) && IsServerMsgId(itemId)) {
-		_nonChannelMessages.emplace(itemId, item);
+		_nonChannelMessages.emplace({ PeerId(), itemId }, item);
 	}
 }
 
@@ -2462,18 +2447,16 @@ void Session::checkTTLs() {
 void Session::processMessagesDeleted(
 		PeerId peerId,
 		const QVector<MTPint> &data) {
-	const auto list = messagesList(peerId);
 	const auto affected = historyLoaded(peerId);
-	if (!list && !affected) {
+	if (_messages.empty() && !affected) {
 		return;
 	}
 
 	auto historiesToCheck = base::flat_set<not_null<History*>>();
 	for (const auto &messageId : data) {
-		const auto i = list ? list->find(messageId.v) : Messages::iterator();
-		if (list && i != list->end()) {
-			const auto history = i->second->history();
-			i->second->destroy();
+		if (const auto item = _messages.find({ peerId, messageId.v })) {
+			const auto history = item->history();
+			item->destroy();
 			if (!history->chatListMessageKnown()) {
 				historiesToCheck.emplace(history);
 			}
@@ -2537,10 +2520,10 @@ void Session::unregisterMessage(not_null<HistoryItem*> item) {
 			++i;
 		}
 	}
-	messagesListForInsert(peerId)->erase(itemId);
+	_messages.erase({ peerId, itemId });
 
 	if (!peerIsChannel(peerId) && IsServerMsgId(itemId)) {
-		_nonChannelMessages.erase(itemId);
+		_nonChannelMessages.erase({ PeerId(), itemId });
 	}
 }
 
@@ -2569,13 +2552,7 @@ HistoryItem *Session::message(PeerId peerId, MsgId itemId) const {
 		return nullptr;
 	}
 
-	const auto data = messagesList(peerId);
-	if (!data) {
-		return nullptr;
-	}
-
-	const auto i = data->find(itemId);
-	return (i != data->end()) ? i->second.get() : nullptr;
+	return _messages.find({ peerId, itemId });
 }
 
 HistoryItem *Session::message(
@@ -2592,8 +2569,7 @@ HistoryItem *Session::nonChannelMessage(MsgId itemId) const {
 	if (!IsServerMsgId(itemId)) {
 		return nullptr;
 	}
-	const auto i = _nonChannelMessages.find(itemId);
-	return (i != end(_nonChannelMessages)) ? i->second.get() : nullptr;
+	return _nonChannelMessages.find({ PeerId(), itemId });
 }
 
 void Session::updateDependentMessages(not_null<HistoryItem*> item) {
@@ -11,6 +11,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "dialogs/dialogs_main_list.h"
 #include "data/data_groups.h"
 #include "data/data_cloud_file.h"
+#include "data/data_messages_registry.h"
 #include "history/history_location_manager.h"
 #include "base/timer.h"
 
@@ -764,8 +765,6 @@ public:
 	void clearLocalStorage();
 
 private:
-	using Messages = std::unordered_map<MsgId, not_null<HistoryItem*>>;
-
 	void suggestStartExport();
 
 	void setupMigrationViewer();
@@ -787,8 +786,6 @@ private:
 		Folder *requestFolder,
 		const MTPDdialogFolder &data);
 
-	const Messages *messagesList(PeerId peerId) const;
-	not_null<Messages*> messagesListForInsert(PeerId peerId);
 	not_null<HistoryItem*> registerMessage(
 		std::unique_ptr<HistoryItem> item);
 	HistoryItem *changeMessageId(PeerId peerId, MsgId wasId, MsgId nowId);
@@ -937,14 +934,14 @@ private:
 	Dialogs::IndexedList _contactsNoChatsList;
 
 	MsgId _localMessageIdCounter = StartClientMsgId;
-	std::unordered_map<PeerId, Messages> _messages;
+	MessagesRegistry _messages;
 	std::map<
 		not_null<HistoryItem*>,
 		base::flat_set<not_null<HistoryItem*>>> _dependentMessages;
 	std::map<TimeId, base::flat_set<not_null<HistoryItem*>>> _ttlMessages;
 	base::Timer _ttlCheckTimer;
 
-	std::unordered_map<MsgId, not_null<HistoryItem*>> _nonChannelMessages;
+	MessagesRegistry _nonChannelMessages; // By FullMsgId(PeerId(), id).
 
 	base::flat_map<uint64, FullMsgId> _messageByRandomId;
 	base::flat_map<uint64, SentData> _sentMessagesData;
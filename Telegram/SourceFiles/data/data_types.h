@@ -320,6 +320,9 @@ enum class MessageFlag : uint64 {
 	ReactionsAreTags      = (1ULL << 43),
 
 	ShortcutMessage       = (1ULL << 44),
+
+	// Some view was created, text needs to be prepared for display.
+	HasBeenViewed         = (1ULL << 45),
 };
 inline constexpr bool is_flag_type(MessageFlag) { return true; }
 using MessageFlags = base::flags<MessageFlag>;
@@ -39,6 +39,16 @@ namespace Data {
 namespace {
 
 constexpr auto kMaxPerRequest = 100;
+
+// Repaints due within one display frame are dispatched together.
+constexpr auto kRepaintFrame = crl::time(16);
+
+// If repaints keep being dispatched later than that, the main thread
+// can't keep up with the frame rate and all emoji animations are slowed.
+constexpr auto kRepaintLateThreshold = 2 * kRepaintFrame;
+constexpr auto kRepaintLateCountToSlowdown = 4;
+constexpr auto kRepaintInTimeCountToSpeedup = 60;
+constexpr auto kMaxRepaintSlowdown = 4;
 #if 0 // inject-to-on_main
 constexpr auto kUnsubscribeUpdatesDelay = 3 * crl::time(1000);
 #endif
@@ -835,6 +845,9 @@ void CustomEmojiManager::requestFinished() {
 void CustomEmojiManager::repaintLater(
 		not_null<Ui::CustomEmoji::Instance*> instance,
 		Ui::CustomEmoji::RepaintRequest request) {
+	if (_repaintSlowdown > 1) {
+		request.when += (_repaintSlowdown - 1) * request.duration;
+	}
 	auto &bunch = _repaints[request.duration];
 	if (bunch.when < request.when) {
 		if (bunch.when > 0) {
@@ -890,6 +903,10 @@ void CustomEmojiManager::scheduleRepaintTimer() {
 				next = bunch.when;
 			}
 		}
+		if (next) {
+			next = ((next + kRepaintFrame - 1) / kRepaintFrame)
+				* kRepaintFrame;
+		}
 		if (next && (!_repaintNext || _repaintNext > next)) {
 			const auto now = crl::now();
 			if (now >= next) {
@@ -911,10 +928,13 @@ void CustomEmojiManager::invokeRepaints() {
 	}
 	const auto now = crl::now();
 	auto repaint = std::vector<base::weak_ptr<Ui::CustomEmoji::Instance>>();
+	auto earliest = crl::time();
 	for (auto i = begin(_repaints); i != end(_repaints);) {
 		if (i->second.when > now) {
 			++i;
 			continue;
+		} else if (!earliest || earliest > i->second.when) {
+			earliest = i->second.when;
 		}
 		auto &list = i->second.instances;
 		if (repaint.empty()) {
@@ -933,12 +953,42 @@ void CustomEmojiManager::invokeRepaints() {
 				strong->repaint();
 			}
 		}
+		updateRepaintSlowdown(now - earliest, crl::now() - now);
 	} else if (_repaintTimer.isActive()) {
 		return;
 	}
 	scheduleRepaintTimer();
 }
 
+void CustomEmojiManager::updateRepaintSlowdown(
+		crl::time lateness,
+		crl::time spent) {
+	const auto was = _repaintSlowdown;
+	if (lateness > kRepaintLateThreshold) {
+		_repaintInTimeCount = 0;
+		if (++_repaintLateCount >= kRepaintLateCountToSlowdown) {
+			_repaintLateCount = 0;
+			_repaintSlowdown = std::min(
+				_repaintSlowdown + 1,
+				kMaxRepaintSlowdown);
+		}
+	} else {
+		_repaintLateCount = 0;
+		if (++_repaintInTimeCount >= kRepaintInTimeCountToSpeedup) {
+			_repaintInTimeCount = 0;
+			_repaintSlowdown = std::max(_repaintSlowdown - 1, 1);
+		}
+	}
+	if (_repaintSlowdown != was) {
+		DEBUG_LOG(("Custom Emoji: repaint slowdown %1 -> %2 "
+			"(late by %3ms, dispatch took %4ms)."
+			).arg(was
+			).arg(_repaintSlowdown
+			).arg(lateness
+			).arg(spent));
+	}
+}
+
 Main::Session &CustomEmojiManager::session() const {
 	return _owner->session();
 }
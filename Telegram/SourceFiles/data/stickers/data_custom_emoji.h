@@ -132,6 +132,7 @@ private:
 	void scheduleRepaintTimer();
 	bool checkEmptyRepaints();
 	void invokeRepaints();
+	void updateRepaintSlowdown(crl::time lateness, crl::time spent);
 	void fillColoredFlags(not_null<DocumentData*> document);
 	void processLoaders(not_null<DocumentData*> document);
 	void processListeners(not_null<DocumentData*> document);
@@ -184,6 +185,9 @@ private:
 	crl::time _repaintNext = 0;
 	base::Timer _repaintTimer;
 	bool _repaintTimerScheduled = false;
+	int _repaintSlowdown = 1;
+	int _repaintLateCount = 0;
+	int _repaintInTimeCount = 0;
 	bool _requestSetsScheduled = false;
 
 	std::vector<InternalEmojiData> _internalEmoji;
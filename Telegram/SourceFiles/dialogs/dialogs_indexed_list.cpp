@@ -12,6 +12,28 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "history/history.h"
 
 namespace Dialogs {
+namespace {
+
+// Every row matching the new words matches the old words as well,
+// if each old word is a prefix of some new word.
+[[nodiscard]] bool QueryRefines(
+		const QStringList &was,
+		const QStringList &now) {
+	if (was.isEmpty()) {
+		return false;
+	}
+	for (const auto &word : was) {
+		const auto prefix = [&](const QString &refined) {
+			return refined.startsWith(word);
+		};
+		if (ranges::none_of(now, prefix)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+} // namespace
 
 IndexedList::IndexedList(SortMode sortMode, FilterId filterId)
 : _sortMode(sortMode)
@@ -24,6 +46,7 @@ RowsByLetter IndexedList::addToEnd(Key key) {
 	if (const auto row = _list.getRow(key)) {
 		return { row };
 	}
+	invalidateFiltered();
 
 	auto result = RowsByLetter{ _list.addToEnd(key) };
 	for (const auto &ch : key.entry()->chatListFirstLetters()) {
@@ -40,6 +63,7 @@ Row *IndexedList::addByName(Key key) {
 	if (const auto row = _list.getRow(key)) {
 		return row;
 	}
+	invalidateFiltered();
 
 	const auto result = _list.addByName(key);
 	for (const auto &ch : key.entry()->chatListFirstLetters()) {
@@ -53,6 +77,7 @@ Row *IndexedList::addByName(Key key) {
 }
 
 void IndexedList::adjustByDate(const RowsByLetter &links) {
+	invalidateFiltered();
 	_list.adjustByDate(links.main);
 	for (const auto &[ch, row] : links.letters) {
 		if (auto it = _index.find(ch); it != _index.cend()) {
@@ -70,6 +95,7 @@ bool IndexedList::updateHeight(Key key, float64 narrowRatio) {
 }
 
 void IndexedList::moveToTop(Key key) {
+	invalidateFiltered();
 	if (_list.moveToTop(key)) {
 		for (const auto &ch : key.entry()->chatListFirstLetters()) {
 			if (auto it = _index.find(ch); it != _index.cend()) {
@@ -80,6 +106,7 @@ void IndexedList::moveToTop(Key key) {
 }
 
 void IndexedList::movePinned(Row *row, int deltaSign) {
+	invalidateFiltered();
 	auto swapPinnedIndexWith = find(row);
 	Assert(swapPinnedIndexWith != cend());
 	if (deltaSign > 0) {
@@ -124,6 +151,7 @@ void IndexedList::adjustByName(
 		const base::flat_set<QChar> &oldLetters) {
 	Expects(_sortMode == SortMode::Name);
 
+	invalidateFiltered();
 	const auto mainRow = _list.adjustByName(key);
 	if (!mainRow) return;
 
@@ -160,6 +188,7 @@ void IndexedList::adjustNames(
 		FilterId filterId,
 		not_null<History*> history,
 		const base::flat_set<QChar> &oldLetters) {
+	invalidateFiltered();
 	const auto key = Dialogs::Key(history);
 	auto mainRow = _list.getRow(key);
 	if (!mainRow) return;
@@ -195,6 +224,7 @@ void IndexedList::adjustNames(
 }
 
 void IndexedList::remove(Key key, Row *replacedBy) {
+	invalidateFiltered();
 	if (_list.remove(key, replacedBy)) {
 		for (const auto &ch : key.entry()->chatListFirstLetters()) {
 			if (const auto it = _index.find(ch); it != _index.cend()) {
@@ -205,13 +235,26 @@ void IndexedList::remove(Key key, Row *replacedBy) {
 }
 
 void IndexedList::clear() {
+	invalidateFiltered();
 	_list.clear();
 	_index.clear();
 }
 
+void IndexedList::invalidateFiltered() {
+	_filteredWords.clear();
+	_filteredRows.clear();
+}
+
 std::vector<not_null<Row*>> IndexedList::filtered(
 		const QStringList &words) const {
+	const auto refined = QueryRefines(_filteredWords, words);
+	if (refined && _filteredWords == words) {
+		return _filteredRows;
+	}
 	const auto minimal = [&]() -> const Dialogs::List* {
+		if (refined) {
+			return nullptr;
+		}
 		if (empty()) {
 			return nullptr;
 		}
@@ -229,12 +272,7 @@ std::vector<not_null<Row*>> IndexedList::filtered(
 		}
 		return result;
 	}();
-	auto result = std::vector<not_null<Row*>>();
-	if (!minimal || minimal->empty()) {
-		return result;
-	}
-	result.reserve(minimal->size());
-	for (const auto &row : *minimal) {
+	const auto allFound = [&](not_null<Row*> row) {
 		const auto &nameWords = row->entry()->chatListNameWords();
 		const auto found = [&](const QString &word) {
 			for (const auto &name : nameWords) {
@@ -244,18 +282,32 @@ std::vector<not_null<Row*>> IndexedList::filtered(
 			}
 			return false;
 		};
-		const auto allFound = [&] {
-			for (const auto &word : words) {
-				if (!found(word)) {
-					return false;
-				}
+		for (const auto &word : words) {
+			if (!found(word)) {
+				return false;
+			}
+		}
+		return true;
+	};
+	auto result = std::vector<not_null<Row*>>();
+	if (refined) {
+		// The query was typed further, so check only previous results.
+		result.reserve(_filteredRows.size());
+		for (const auto &row : _filteredRows) {
+			if (allFound(row)) {
+				result.push_back(row);
+			}
+		}
+	} else if (minimal && !minimal->empty()) {
+		result.reserve(minimal->size());
+		for (const auto &row : *minimal) {
+			if (allFound(row)) {
+				result.push_back(row);
 			}
-			return true;
-		}();
-		if (allFound) {
-			result.push_back(row);
 		}
 	}
+	_filteredWords = words;
+	_filteredRows = result;
 	return result;
 }
 
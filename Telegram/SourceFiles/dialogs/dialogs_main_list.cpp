@@ -20,7 +20,8 @@ MainList::MainList(
 	not_null<Main::Session*> session,
 	FilterId filterId,
 	rpl::producer<int> pinnedLimit)
-: _filterId(filterId)
+: _session(session)
+, _filterId(filterId)
 , _all(SortMode::Date, filterId)
 , _pinned(filterId, 1) {
 	_unreadState.known = true;
@@ -35,6 +36,13 @@ MainList::MainList(
 	) | rpl::start_with_next([=](const Data::NameUpdate &update) {
 		_all.peerNameChanged(_filterId, update.peer, update.oldFirstLetters);
 	}, _lifetime);
+
+	session->changes().batchFinished(
+	) | rpl::start_with_next([=] {
+		if (base::take(_unreadStateChangePending)) {
+			_unreadStateChangesBatched.fire({});
+		}
+	}, _lifetime);
 }
 
 bool MainList::empty() const {
@@ -205,10 +213,23 @@ UnreadState MainList::unreadState() const {
 	return result;
 }
 
+void MainList::unreadStateChanged(const UnreadState &wasState) {
+	_unreadStateChanges.fire_copy(wasState);
+	if (_session->changes().batched()) {
+		_unreadStateChangePending = true;
+	} else {
+		_unreadStateChangesBatched.fire({});
+	}
+}
+
 rpl::producer<UnreadState> MainList::unreadStateChanges() const {
 	return _unreadStateChanges.events();
 }
 
+rpl::producer<> MainList::unreadStateChangesBatched() const {
+	return _unreadStateChangesBatched.events();
+}
+
 not_null<IndexedList*> MainList::indexed() {
 	return &_all;
 }
@@ -45,6 +45,10 @@ public:
 	[[nodiscard]] UnreadState unreadState() const;
 	[[nodiscard]] rpl::producer<UnreadState> unreadStateChanges() const;
 
+	// Fires once per Data::Changes batch, for the badge and menus only.
+	// Listeners that forward deltas to parent lists need every change.
+	[[nodiscard]] rpl::producer<> unreadStateChangesBatched() const;
+
 	[[nodiscard]] not_null<IndexedList*> indexed();
 	[[nodiscard]] not_null<const IndexedList*> indexed() const;
 	[[nodiscard]] not_null<PinnedList*> pinned();
@@ -58,13 +62,17 @@ private:
 	void recomputeFullListSize();
 
 	inline auto unreadStateChangeNotifier(bool notify);
+	void unreadStateChanged(const UnreadState &wasState);
 
+	const not_null<Main::Session*> _session;
 	FilterId _filterId = 0;
 	IndexedList _all;
 	PinnedList _pinned;
 	UnreadState _unreadState;
 	UnreadState _cloudUnreadState;
 	rpl::event_stream<UnreadState> _unreadStateChanges;
+	rpl::event_stream<> _unreadStateChangesBatched;
+	bool _unreadStateChangePending = false;
 	rpl::variable<int> _fullListSize = 0;
 	int _cloudListSize = 0;
 
@@ -79,7 +87,7 @@ auto MainList::unreadStateChangeNotifier(bool notify) {
 	const auto wasState = notify ? unreadState() : UnreadState();
 	return gsl::finally([=] {
 		if (notify) {
-			_unreadStateChanges.fire_copy(wasState);
+			unreadStateChanged(wasState);
 		}
 	});
 }
@@ -220,6 +220,12 @@ struct ApiWrap::ChatProcess {
 
 	FnMut<void(MTPmessages_Messages&&)> requestDone;
 
+	// The next slice is requested while the current one is processed.
+	// It is parsed only when requested, to keep the parsing order.
+	std::optional<MTPmessages_Messages> prefetched;
+	bool prefetching = false;
+	bool waitingPrefetched = false;
+
 	int localSplitIndex = 0;
 	int32 largestIdPlusOne = 1;
 
@@ -1596,6 +1602,13 @@ void ApiWrap::appendChatsSlice(
 void ApiWrap::requestMessagesSlice() {
 	Expects(_chatProcess != nullptr);
 
+	if (auto prefetched = base::take(_chatProcess->prefetched)) {
+		handleMessagesSlice(*prefetched);
+		return;
+	} else if (_chatProcess->prefetching) {
+		_chatProcess->waitingPrefetched = true;
+		return;
+	}
 	const auto count = _chatProcess->info.messagesCountPerSplit[
 		_chatProcess->localSplitIndex];
 	if (!count) {
@@ -1608,21 +1621,54 @@ void ApiWrap::requestMessagesSlice() {
 		-kMessagesSliceLimit,
 		kMessagesSliceLimit,
 		[=](const MTPmessages_Messages &result) {
+		handleMessagesSlice(result);
+	});
+}
+
+void ApiWrap::prefetchMessagesSlice(int32 offsetId) {
+	Expects(_chatProcess != nullptr);
+	Expects(!_chatProcess->prefetching);
+	Expects(!_chatProcess->prefetched.has_value());
+
+	_chatProcess->prefetching = true;
+	requestChatMessages(
+		_chatProcess->info.splits[_chatProcess->localSplitIndex],
+		offsetId,
+		-kMessagesSliceLimit,
+		kMessagesSliceLimit,
+		[=](MTPmessages_Messages &&result) {
 		Expects(_chatProcess != nullptr);
 
-		result.match([&](const MTPDmessages_messagesNotModified &data) {
-			error("Unexpected messagesNotModified received.");
-		}, [&](const auto &data) {
-			if constexpr (MTPDmessages_messages::Is<decltype(data)>()) {
-				_chatProcess->lastSlice = true;
-			}
-			loadMessagesFiles(Data::ParseMessagesSlice(
-				_chatProcess->context,
-				data.vmessages(),
-				data.vusers(),
-				data.vchats(),
-				_chatProcess->info.relativePath));
-		});
+		_chatProcess->prefetching = false;
+		if (base::take(_chatProcess->waitingPrefetched)) {
+			handleMessagesSlice(result);
+		} else {
+			_chatProcess->prefetched = std::move(result);
+		}
+	});
+}
+
+void ApiWrap::handleMessagesSlice(const MTPmessages_Messages &result) {
+	Expects(_chatProcess != nullptr);
+
+	result.match([&](const MTPDmessages_messagesNotModified &data) {
+		error("Unexpected messagesNotModified received.");
+	}, [&](const auto &data) {
+		if constexpr (MTPDmessages_messages::Is<decltype(data)>()) {
+			_chatProcess->lastSlice = true;
+		}
+		auto slice = Data::ParseMessagesSlice(
+			_chatProcess->context,
+			data.vmessages(),
+			data.vusers(),
+			data.vchats(),
+			_chatProcess->info.relativePath);
+		if (!_chatProcess->lastSlice && !slice.list.empty()) {
+			// Request the next slice while files of this one are loaded
+			// and it is written, the same way finishMessagesSlice() would.
+			prefetchMessagesSlice(slice.list.back().id + 1);
+		}
+		loadMessagesFiles(std::move(slice));
 	});
 }
 
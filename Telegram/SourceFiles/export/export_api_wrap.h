@@ -173,6 +173,8 @@ private:
 	void checkFirstMessageDate(int localSplitIndex, int count);
 	void messagesCountLoaded(int localSplitIndex, int count);
 	void requestMessagesSlice();
+	void prefetchMessagesSlice(int32 offsetId);
+	void handleMessagesSlice(const MTPmessages_Messages &result);
 	void requestChatMessages(
 		int splitIndex,
 		int offsetId,
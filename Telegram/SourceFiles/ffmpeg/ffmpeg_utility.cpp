@@ -20,7 +20,13 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 
 #ifdef LIB_FFMPEG_USE_QT_PRIVATE_API
 #include <private/qdrawhelper_p.h>
-#endif // LIB_FFMPEG_USE_QT_PRIVATE_API
+#elif defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2) // LIB_FFMPEG_USE_QT_PRIVATE_API
+#define LIB_FFMPEG_PREMULTIPLY_SSE2
+#include <emmintrin.h>
+#elif defined __ARM_NEON || defined _M_ARM64 // LIB_FFMPEG_USE_QT_PRIVATE_API || __SSE2__
+#define LIB_FFMPEG_PREMULTIPLY_NEON
+#include <arm_neon.h>
+#endif // LIB_FFMPEG_USE_QT_PRIVATE_API || __SSE2__ || __ARM_NEON
 
 extern "C" {
 #include <libavutil/opt.h>
@@ -78,12 +84,78 @@ void UnPremultiplyLine(uchar *dst, const uchar *src, int intsCount) {
 #endif // LIB_FFMPEG_USE_QT_PRIVATE_API
 }
 
+#ifdef LIB_FFMPEG_PREMULTIPLY_SSE2
+// Computes the same (c * a + ((c * a) >> 8) + 0x80) >> 8 as qPremultiply,
+// four pixels at a time, with alpha lanes multiplied by 255 to stay as is.
+int PremultiplyLineSimd(uint *dst, const uint *src, int intsCount) {
+	const auto zero = _mm_setzero_si128();
+	const auto alphaMask = _mm_set1_epi32(int(0xFF000000));
+	const auto keepAlpha = _mm_set_epi16(0xFF, 0, 0, 0, 0xFF, 0, 0, 0);
+	const auto half = _mm_set1_epi16(0x80);
+	const auto premultiply = [&](__m128i pixels) {
+		const auto alpha = _mm_or_si128(
+			_mm_shufflehi_epi16(
+				_mm_shufflelo_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3)),
+				_MM_SHUFFLE(3, 3, 3, 3)),
+			keepAlpha);
+		const auto t = _mm_mullo_epi16(pixels, alpha);
+		return _mm_srli_epi16(
+			_mm_add_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), half),
+			8);
+	};
+	auto i = 0;
+	for (; i + 4 <= intsCount; i += 4) {
+		const auto pixels = _mm_loadu_si128(
+			reinterpret_cast<const __m128i*>(src + i));
+		const auto opaque = _mm_cmpeq_epi32(
+			_mm_and_si128(pixels, alphaMask),
+			alphaMask);
+		if (_mm_movemask_epi8(opaque) == 0xFFFF) {
+			if (dst != src) {
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), pixels);
+			}
+			continue;
+		}
+		const auto low = premultiply(_mm_unpacklo_epi8(pixels, zero));
+		const auto high = premultiply(_mm_unpackhi_epi8(pixels, zero));
+		_mm_storeu_si128(
+			reinterpret_cast<__m128i*>(dst + i),
+			_mm_packus_epi16(low, high));
+	}
+	return i;
+}
+#elif defined LIB_FFMPEG_PREMULTIPLY_NEON // LIB_FFMPEG_PREMULTIPLY_SSE2
+// Computes the same (c * a + ((c * a) >> 8) + 0x80) >> 8 as qPremultiply,
+// eight pixels at a time.
+int PremultiplyLineSimd(uint *dst, const uint *src, int intsCount) {
+	const auto premultiply = [](uint8x8_t channel, uint8x8_t alpha) {
+		const auto t = vmull_u8(channel, alpha);
+		return vraddhn_u16(t, vshrq_n_u16(t, 8));
+	};
+	auto i = 0;
+	for (; i + 8 <= intsCount; i += 8) {
+		auto pixels = vld4_u8(reinterpret_cast<const uint8_t*>(src + i));
+		const auto alpha = pixels.val[3];
+		pixels.val[0] = premultiply(pixels.val[0], alpha);
+		pixels.val[1] = premultiply(pixels.val[1], alpha);
+		pixels.val[2] = premultiply(pixels.val[2], alpha);
+		vst4_u8(reinterpret_cast<uint8_t*>(dst + i), pixels);
+	}
+	return i;
+}
+#endif // LIB_FFMPEG_PREMULTIPLY_SSE2 || LIB_FFMPEG_PREMULTIPLY_NEON
+
 void PremultiplyLine(uchar *dst, const uchar *src, int intsCount) {
 	const auto udst = reinterpret_cast<uint*>(dst);
 	[[maybe_unused]] const auto usrc = reinterpret_cast<const uint*>(src);
 
 #ifndef LIB_FFMPEG_USE_QT_PRIVATE_API
-	for (auto i = 0; i != intsCount; ++i) {
+#if defined LIB_FFMPEG_PREMULTIPLY_SSE2 || defined LIB_FFMPEG_PREMULTIPLY_NEON
+	auto i = PremultiplyLineSimd(udst, usrc, intsCount);
+#else // LIB_FFMPEG_PREMULTIPLY_SSE2 || LIB_FFMPEG_PREMULTIPLY_NEON
+	auto i = 0;
+#endif // LIB_FFMPEG_PREMULTIPLY_SSE2 || LIB_FFMPEG_PREMULTIPLY_NEON
+	for (; i != intsCount; ++i) {
 		udst[i] = qPremultiply(usrc[i]);
 	}
 #else // !LIB_FFMPEG_USE_QT_PRIVATE_API
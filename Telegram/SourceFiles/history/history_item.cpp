@@ -1229,6 +1229,10 @@ uint8 HistoryItem::contentColorIndex() const {
 std::unique_ptr<HistoryView::Element> HistoryItem::createView(
 		not_null<HistoryView::ElementDelegate*> delegate,
 		HistoryView::Element *replacing) {
+	if (!(_flags & MessageFlag::HasBeenViewed)) {
+		_flags |= MessageFlag::HasBeenViewed;
+		startHighlightProcess();
+	}
 	if (isService()) {
 		return std::make_unique<HistoryView::Service>(
 			delegate,
@@ -3082,18 +3086,26 @@ void HistoryItem::setText(const TextWithEntities &textWithEntities) {
 }
 
 void HistoryItem::setTextValue(TextWithEntities text, bool force) {
-	if (const auto processId = Spellchecker::TryHighlightSyntax(text)) {
-		_flags |= MessageFlag::InHighlightProcess;
-		history()->owner().registerHighlightProcess(processId, this);
-	}
 	const auto had = !_text.empty();
 	_text = std::move(text);
 	RemoveComponents(HistoryMessageTranslation::Bit());
+
+	// Most of the messages are never displayed, highlight when viewed.
+	if (_flags & MessageFlag::HasBeenViewed) {
+		startHighlightProcess();
+	}
 	if (had || force) {
 		history()->owner().requestItemTextRefresh(this);
 	}
 }
 
+void HistoryItem::startHighlightProcess() {
+	if (const auto processId = Spellchecker::TryHighlightSyntax(_text)) {
+		_flags |= MessageFlag::InHighlightProcess;
+		history()->owner().registerHighlightProcess(processId, this);
+	}
+}
+
 bool HistoryItem::inHighlightProcess() const {
 	return _flags & MessageFlag::InHighlightProcess;
 }
@@ -533,13 +533,23 @@ void Sticker::setupPlayer() {
 	Expects(_dataMedia != nullptr);
 
 	if (_data->sticker()->isLottie()) {
-		_player = std::make_unique<LottiePlayer>(
-			ChatHelpers::LottiePlayerFromDocument(
+		const auto box = countOptimalSize() * style::DevicePixelRatio();
+		auto create = [=] {
+			return ChatHelpers::LottiePlayerFromDocument(
 				_dataMedia.get(),
 				_replacements,
 				_cachingTag,
-				countOptimalSize() * style::DevicePixelRatio(),
-				Lottie::Quality::High));
+				box,
+				Lottie::Quality::High);
+		};
+		_player = (Core::App().settings().loopAnimatedStickers()
+			&& canShareLottiePlayer())
+			? SharedLottiePlayer::Make(
+				_data,
+				box,
+				int(_cachingTag),
+				std::move(create))
+			: std::make_unique<LottiePlayer>(create());
 	} else if (_data->sticker()->isWebm()) {
 		_player = std::make_unique<WebmPlayer>(
 			_dataMedia->owner()->location(),
@@ -551,6 +561,16 @@ void Sticker::setupPlayer() {
 	playerCreated();
 }
 
+bool Sticker::canShareLottiePlayer() const {
+	// Dice, play-once emoji, recolored and premium stickers
+	// track their own frames, so only plain looping ones are shared.
+	return !_replacements
+		&& (_diceIndex < 0)
+		&& !_emojiSticker
+		&& !_customEmojiPart
+		&& !hasPremiumEffect();
+}
+
 void Sticker::checkPremiumEffectStart() {
 	if (!_premiumEffectPlayed && hasPremiumEffect()) {
 		_premiumEffectPlayed = true;
@@ -568,6 +588,21 @@ void Sticker::playerCreated() {
 
 	_parent->history()->owner().registerHeavyViewPart(_parent);
 	_player->setRepaintCallback([=] { _parent->customEmojiRepaint(); });
+
+	if (!_loopChangesTracked
+		&& _data->sticker()->isLottie()
+		&& canShareLottiePlayer()) {
+		// Players are shared only while stickers loop,
+		// so the player is recreated when the setting changes.
+		_loopChangesTracked = true;
+		Core::App().settings().loopAnimatedStickersChanges(
+		) | rpl::start_with_next([=] {
+			if (_player) {
+				unloadPlayer();
+				_parent->history()->owner().requestViewRepaint(_parent);
+			}
+		}, _loopChangesLifetime);
+	}
 }
 
 bool Sticker::hasHeavyPart() const {
@@ -118,6 +118,7 @@ private:
 	void emojiStickerClicked();
 	void premiumStickerClicked();
 	void checkPremiumEffectStart();
+	[[nodiscard]] bool canShareLottiePlayer() const;
 
 	const not_null<Element*> _parent;
 	const not_null<DocumentData*> _data;
@@ -128,6 +129,7 @@ private:
 	QSize _size;
 	QImage _lastDiceFrame;
 	QString _diceEmoji;
+	rpl::lifetime _loopChangesLifetime;
 	int _diceIndex = -1;
 	mutable int _frameIndex = -1;
 	mutable int _framesCount = -1;
@@ -140,6 +142,7 @@ private:
 	bool _customEmojiPart : 1 = false;
 	bool _emojiSticker : 1 = false;
 	bool _webpagePart : 1 = false;
+	bool _loopChangesTracked : 1 = false;
 
 };
 
@@ -13,9 +13,23 @@ namespace HistoryView {
 namespace {
 
 using ClipNotification = ::Media::Clip::Notification;
+using SharedLottieKey = std::tuple<DocumentData*, int, int, int>;
 
 } // namespace
 
+struct SharedLottiePlayer::Shared {
+	explicit Shared(std::unique_ptr<Lottie::SinglePlayer> lottie);
+	~Shared();
+
+	[[nodiscard]] static auto Registry()
+	-> base::flat_map<SharedLottieKey, std::weak_ptr<Shared>>&;
+
+	SharedLottieKey key;
+	LottiePlayer player;
+	base::flat_map<not_null<SharedLottiePlayer*>, Fn<void()>> repaints;
+
+};
+
 LottiePlayer::LottiePlayer(std::unique_ptr<Lottie::SinglePlayer> lottie)
 : _lottie(std::move(lottie)) {
 }
@@ -58,6 +72,114 @@ bool LottiePlayer::markFrameShown() {
 	return _lottie->markFrameShown();
 }
 
+SharedLottiePlayer::Shared::Shared(
+	std::unique_ptr<Lottie::SinglePlayer> lottie)
+: player(std::move(lottie)) {
+	player.setRepaintCallback([=] {
+		for (const auto &[view, callback] : base::duplicate(repaints)) {
+			callback();
+		}
+	});
+}
+
+auto SharedLottiePlayer::Shared::Registry()
+-> base::flat_map<SharedLottieKey, std::weak_ptr<Shared>>& {
+	static auto result = base::flat_map<
+		SharedLottieKey,
+		std::weak_ptr<Shared>>();
+	return result;
+}
+
+SharedLottiePlayer::Shared::~Shared() {
+	auto &players = Registry();
+	const auto i = players.find(key);
+	if (i != end(players) && i->second.expired()) {
+		players.erase(i);
+	}
+}
+
+std::unique_ptr<StickerPlayer> SharedLottiePlayer::Make(
+		not_null<DocumentData*> document,
+		QSize box,
+		int cachingTag,
+		FnMut<std::unique_ptr<Lottie::SinglePlayer>()> create) {
+	const auto key = SharedLottieKey{
+		document.get(),
+		box.width(),
+		box.height(),
+		cachingTag,
+	};
+	auto &players = Shared::Registry();
+	auto &weak = players[key];
+	auto shared = weak.lock();
+	if (!shared) {
+		shared = std::make_shared<Shared>(create());
+		shared->key = key;
+		weak = shared;
+	}
+	return std::unique_ptr<StickerPlayer>(
+		new SharedLottiePlayer(std::move(shared)));
+}
+
+SharedLottiePlayer::SharedLottiePlayer(std::shared_ptr<Shared> shared)
+: _shared(std::move(shared)) {
+}
+
+SharedLottiePlayer::~SharedLottiePlayer() {
+	_shared->repaints.remove(this);
+}
+
+void SharedLottiePlayer::setRepaintCallback(Fn<void()> callback) {
+	_shared->repaints[this] = std::move(callback);
+}
+
+bool SharedLottiePlayer::ready() {
+	return _shared->player.ready();
+}
+
+int SharedLottiePlayer::framesCount() {
+	return _shared->player.framesCount();
+}
+
+SharedLottiePlayer::FrameInfo SharedLottiePlayer::frame(
+		QSize size,
+		QColor colored,
+		bool mirrorHorizontal,
+		crl::time now,
+		bool paused) {
+	// Other views keep advancing the shared player,
+	// so a paused view keeps drawing the frame it had when paused.
+	auto result = (paused && !_pausedFrame.image.isNull())
+		? _pausedFrame
+		: _shared->player.frame(
+			size,
+			QColor(0, 0, 0, 0),
+			mirrorHorizontal,
+			now,
+			paused);
+	_pausedFrame = paused ? result : FrameInfo();
+	if (colored.alpha() == 0 || result.image.isNull()) {
+		_colored = QImage();
+		return result;
+	}
+
+	// The selection overlay differs between the views,
+	// so it is applied to the shared frame once per frame here.
+	if (_coloredIndex != result.index
+		|| _coloredWith != colored
+		|| _colored.isNull()) {
+		_colored = Images::Colored(base::duplicate(result.image), colored);
+		_coloredWith = colored;
+		_coloredIndex = result.index;
+	}
+	result.image = _colored;
+	return result;
+}
+
+bool SharedLottiePlayer::markFrameShown() {
+	return _shared->player.markFrameShown();
+}
+
 WebmPlayer::WebmPlayer(
 	const Core::FileLocation &location,
 	const QByteArray &data,
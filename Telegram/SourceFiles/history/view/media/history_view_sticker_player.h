@@ -12,6 +12,8 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "lottie/lottie_single_player.h"
 #include "media/clip/media_clip_reader.h"
 
+class DocumentData;
+
 namespace Core {
 class FileLocation;
 } // namespace Core
@@ -39,6 +41,42 @@ private:
 
 };
 
+// Views of the same sticker in the same size share one LottiePlayer,
+// so that each frame is rendered once for all of them.
+class SharedLottiePlayer final : public StickerPlayer {
+public:
+	[[nodiscard]] static std::unique_ptr<StickerPlayer> Make(
+		not_null<DocumentData*> document,
+		QSize box,
+		int cachingTag,
+		FnMut<std::unique_ptr<Lottie::SinglePlayer>()> create);
+
+	~SharedLottiePlayer();
+
+	void setRepaintCallback(Fn<void()> callback) override;
+	bool ready() override;
+	int framesCount() override;
+	FrameInfo frame(
+		QSize size,
+		QColor colored,
+		bool mirrorHorizontal,
+		crl::time now,
+		bool paused) override;
+	bool markFrameShown() override;
+
+private:
+	struct Shared;
+
+	explicit SharedLottiePlayer(std::shared_ptr<Shared> shared);
+
+	const std::shared_ptr<Shared> _shared;
+	FrameInfo _pausedFrame;
+	QImage _colored;
+	QColor _coloredWith;
+	int _coloredIndex = -1;
+
+};
+
 class WebmPlayer final : public StickerPlayer {
 public:
 	WebmPlayer(
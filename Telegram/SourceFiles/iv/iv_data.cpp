@@ -8,8 +8,10 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "iv/iv_data.h"
 
 #include "iv/iv_prepare.h"
+#include "lang/lang_keys.h"
 #include "webview/webview_interface.h"
 
+#include <QtCore/QMutex>
 #include <QtCore/QRegularExpression>
 #include <QtCore/QUrl>
 
@@ -18,8 +20,36 @@ namespace {
 
 bool FailureRecorded/* = false*/;
 
+struct CacheKey {
+	Options options;
+	QString langId;
+	int langVersion = 0;
+	int langBaseVersion = 0;
+
+	friend inline bool operator==(
+		const CacheKey &,
+		const CacheKey &) = default;
+};
+
+[[nodiscard]] CacheKey ComputeCacheKey(const Options &options) {
+	return {
+		.options = options,
+		.langId = Lang::Id(),
+		.langVersion = Lang::Version(),
+		.langBaseVersion = Lang::BaseVersion(),
+	};
+}
+
 } // namespace
 
+// Iv::Data is recreated each time the webpage changes, so the last
+// prepared page stays valid while the options and the lang pack stay.
+struct Data::Cache {
+	QMutex mutex;
+	std::optional<CacheKey> key;
+	std::optional<Prepared> prepared;
+};
+
 QByteArray GeoPointId(Geo point) {
 	const auto lat = int(point.lat * 1000000);
 	const auto lon = int(point.lon * 1000000);
@@ -58,7 +88,8 @@ Data::Data(const MTPDwebPage &webpage, const MTPPage &page)
 	.name = (webpage.vsite_name()
 		? qs(*webpage.vsite_name())
 		: SiteNameFromUrl(qs(webpage.vurl())))
-})) {
+}))
+, _cache(std::make_shared<Cache>()) {
 }
 
 QString Data::id() const {
@@ -72,8 +103,32 @@ bool Data::partial() const {
 Data::~Data() = default;
 
 void Data::prepare(const Options &options, Fn<void(Prepared)> done) const {
-	crl::async([source = *_source, options, done = std::move(done)] {
-		done(Prepare(source, options));
+	auto key = ComputeCacheKey(options);
+	auto cached = std::optional<Prepared>();
+	{
+		QMutexLocker lock(&_cache->mutex);
+		if (_cache->prepared && _cache->key == key) {
+			cached = _cache->prepared;
+		}
+	}
+	if (cached) {
+		done(std::move(*cached));
+		return;
+	}
+	crl::async([
+		source = *_source,
+		options,
+		done = std::move(done),
+		cache = _cache,
+		key = std::move(key)
+	] {
+		auto result = Prepare(source, options);
+		{
+			QMutexLocker lock(&cache->mutex);
+			cache->key = key;
+			cache->prepared = result;
+		}
+		done(std::move(result));
 	});
 }
 
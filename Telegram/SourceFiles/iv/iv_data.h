@@ -12,6 +12,7 @@ namespace Iv {
 struct Source;
 
 struct Options {
+	friend inline bool operator==(Options, Options) = default;
 };
 
 struct Prepared {
@@ -48,7 +49,10 @@ public:
 	void prepare(const Options &options, Fn<void(Prepared)> done) const;
 
 private:
+	struct Cache;
+
 	const std::unique_ptr<Source> _source;
+	const std::shared_ptr<Cache> _cache;
 
 };
 
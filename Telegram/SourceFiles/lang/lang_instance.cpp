@@ -792,6 +792,14 @@ QString Id() {
 	return GetInstance().id();
 }
 
+int Version() {
+	return GetInstance().version(Pack::Current);
+}
+
+int BaseVersion() {
+	return GetInstance().version(Pack::Base);
+}
+
 rpl::producer<> Updated() {
 	return GetInstance().updated();
 }
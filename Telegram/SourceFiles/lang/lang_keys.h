@@ -32,6 +32,8 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 namespace Lang {
 
 [[nodiscard]] QString Id();
+[[nodiscard]] int Version();
+[[nodiscard]] int BaseVersion();
 [[nodiscard]] rpl::producer<> Updated();
 [[nodiscard]] QString GetNonDefaultValue(const QByteArray &key);
 [[nodiscard]] QString DefaultLanguageId();
@@ -34,7 +34,7 @@ namespace {
 
 constexpr auto kSuppressRatioAll = 0.2;
 constexpr auto kSuppressRatioSong = 0.05;
-constexpr auto kWaveformCounterBufferSize = 256 * 1024;
+constexpr auto kLongAudioMutexHold = crl::time(4);
 
 QMutex AudioMutex;
 ALCdevice *AudioDevice = nullptr;
@@ -352,8 +352,45 @@ void Mixer::Track::clear() {
 	speed = 1.;
 
 	setExternalData(nullptr);
-	lastUpdateWhen = 0;
-	lastUpdatePosition = 0;
+	externalSyncPoint.reset();
+}
+
+void Mixer::Track::ExternalSyncPoint::set(
+		uint32 playId,
+		crl::time position,
+		crl::time when) {
+	// Writers are serialized by AudioMutex.
+	const auto version = _version.load(std::memory_order_relaxed);
+	_version.store(version + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	_playId.store(playId, std::memory_order_relaxed);
+	_position.store(position, std::memory_order_relaxed);
+	_when.store(when, std::memory_order_relaxed);
+	_version.store(version + 2, std::memory_order_release);
+}
+
+void Mixer::Track::ExternalSyncPoint::reset() {
+	set(0, 0, 0);
+}
+
+Streaming::TimePoint Mixer::Track::ExternalSyncPoint::get(
+		uint32 playId) const {
+	while (true) {
+		const auto version = _version.load(std::memory_order_acquire);
+		if (version & 1) {
+			continue;
+		}
+		const auto id = _playId.load(std::memory_order_relaxed);
+		const auto position = _position.load(std::memory_order_relaxed);
+		const auto when = _when.load(std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (_version.load(std::memory_order_relaxed) != version) {
+			continue;
+		} else if (id != playId || when <= 0) {
+			return Streaming::TimePoint();
+		}
+		return { .trackTime = position, .worldTime = when };
+	}
 }
 
 void Mixer::Track::started() {
@@ -712,8 +749,6 @@ void Mixer::play(
 
 		current->clear(); // Clear all previous state.
 		current->state.id = audio;
-		current->lastUpdateWhen = 0;
-		current->lastUpdatePosition = 0;
 		current->setExternalData(std::move(externalData));
 		current->state.position = (positionMs * current->state.frequency)
 			/ 1000LL;
@@ -763,31 +798,42 @@ Streaming::TimePoint Mixer::getExternalSyncTimePoint(
 		const AudioMsgId &audio) const {
 	Expects(audio.externalPlayId() != 0);
 
-	auto result = Streaming::TimePoint();
-	const auto type = audio.type();
+	return externalSyncPoint(audio);
+}
 
-	QMutexLocker lock(&AudioMutex);
-	const auto track = trackForType(type);
-	if (track && track->state.id == audio && track->lastUpdateWhen > 0) {
-		result.trackTime = track->lastUpdatePosition;
-		result.worldTime = track->lastUpdateWhen;
+crl::time Mixer::getExternalCorrectedTime(const AudioMsgId &audio, crl::time frameMs, crl::time systemMs) {
+	const auto point = externalSyncPoint(audio);
+	if (!point) {
+		return frameMs;
+	}
+	auto result = point.trackTime;
+	if (systemMs > point.worldTime) {
+		result += (systemMs - point.worldTime);
 	}
 	return result;
 }
 
-crl::time Mixer::getExternalCorrectedTime(const AudioMsgId &audio, crl::time frameMs, crl::time systemMs) {
-	auto result = frameMs;
-	const auto type = audio.type();
+Streaming::TimePoint Mixer::externalSyncPoint(
+		const AudioMsgId &audio) const {
+	const auto playId = audio.externalPlayId();
+	if (!playId) {
+		return Streaming::TimePoint();
+	}
 
-	QMutexLocker lock(&AudioMutex);
-	const auto track = trackForType(type);
-	if (track && track->state.id == audio && track->lastUpdateWhen > 0) {
-		result = static_cast<crl::time>(track->lastUpdatePosition);
-		if (systemMs > track->lastUpdateWhen) {
-			result += (systemMs - track->lastUpdateWhen);
+	// Play ids are unique, so instead of reading the current track index,
+	// which is guarded by AudioMutex, we check all tracks of this type.
+	const auto type = audio.type();
+	const auto count = (type == AudioMsgId::Type::Video)
+		? 1
+		: kTogetherLimit;
+	for (auto i = 0; i != count; ++i) {
+		if (const auto track = trackForType(type, i)) {
+			if (const auto result = track->externalSyncPoint.get(playId)) {
+				return result;
+			}
 		}
 	}
-	return result;
+	return Streaming::TimePoint();
 }
 
 void Mixer::externalSoundProgress(const AudioMsgId &audio) {
@@ -798,9 +844,10 @@ void Mixer::externalSoundProgress(const AudioMsgId &audio) {
 	if (current && current->state.length && current->state.frequency) {
 		if (current->state.id == audio
 			&& current->state.state == State::Playing) {
-			current->lastUpdateWhen = crl::now();
-			current->lastUpdatePosition = (current->state.position * 1000LL)
-				/ current->state.frequency;
+			current->externalSyncPoint.set(
+				audio.externalPlayId(),
+				(current->state.position * 1000LL) / current->state.frequency,
+				crl::now());
 		}
 	}
 }
@@ -857,8 +904,7 @@ void Mixer::pause(const AudioMsgId &audio, bool fast) {
 
 		scheduleFaderCallback();
 
-		track->lastUpdateWhen = 0;
-		track->lastUpdatePosition = 0;
+		track->externalSyncPoint.reset();
 	}
 	if (current) updated(current);
 }
@@ -1103,6 +1149,8 @@ void Fader::onTimer() {
 	QMutexLocker lock(&AudioMutex);
 	if (!mixer()) return;
 
+	const auto locked = crl::now();
+
 	constexpr auto kMediaPlayerSuppressDuration = crl::time(150);
 
 	auto volumeChangedAll = false;
@@ -1144,15 +1192,16 @@ void Fader::onTimer() {
 	auto hasFading = (_suppressAll || _suppressSongAnim);
 	auto hasPlaying = false;
 
-	auto updatePlayback = [this, &hasPlaying, &hasFading](AudioMsgId::Type type, int index, float64 volumeMultiplier, bool suppressGainChanged) {
+	// Signals are emitted after AudioMutex is released.
+	auto notifications = std::vector<std::pair<AudioMsgId, int32>>();
+	auto updatePlayback = [&](AudioMsgId::Type type, int index, float64 volumeMultiplier, bool suppressGainChanged) {
 		auto track = mixer()->trackForType(type, index);
 		if (IsStopped(track->state.state) || track->state.state == State::Paused || !track->isStreamCreated()) return;
 
 		auto emitSignals = updateOnePlayback(track, hasPlaying, hasFading, volumeMultiplier, suppressGainChanged);
-		if (emitSignals & EmitError) error(track->state.id);
-		if (emitSignals & EmitStopped) audioStopped(track->state.id);
-		if (emitSignals & EmitPositionUpdated) playPositionUpdated(track->state.id);
-		if (emitSignals & EmitNeedToPreload) needToPreload(track->state.id);
+		if (emitSignals) {
+			notifications.emplace_back(track->state.id, emitSignals);
+		}
 	};
 	auto suppressGainForMusic = ComputeVolume(AudioMsgId::Type::Song);
 	auto suppressGainForMusicChanged = volumeChangedSong || _volumeChangedSong;
@@ -1176,6 +1225,19 @@ void Fader::onTimer() {
 	} else {
 		Audio::ScheduleDetachIfNotUsedSafe();
 	}
+
+	const auto held = crl::now() - locked;
+	lock.unlock();
+
+	if (held >= kLongAudioMutexHold) {
+		DEBUG_LOG(("Audio Info: Fader held the mutex for %1ms.").arg(held));
+	}
+	for (const auto &[id, emitSignals] : notifications) {
+		if (emitSignals & EmitError) error(id);
+		if (emitSignals & EmitStopped) audioStopped(id);
+		if (emitSignals & EmitPositionUpdated) playPositionUpdated(id);
+		if (emitSignals & EmitNeedToPreload) needToPreload(id);
+	}
 }
 
 int32 Fader::updateOnePlayback(Mixer::Track *track, bool &hasPlaying, bool &hasFading, float64 volumeMultiplier, bool volumeChanged) {
@@ -1533,6 +1595,21 @@ Ui::PreparedFileInformation PrepareForSending(
 
 } // namespace Player
 
+namespace {
+
+// A plain abs / max loop over a run of samples, easy to auto-vectorize.
+template <typename SampleType>
+[[nodiscard]] uint16 SamplesPeak(const SampleType *samples, int64 count) {
+	auto result = uint16(0);
+	for (auto i = int64(0); i != count; ++i) {
+		const auto sample = Media::Audio::ReadOneSample(samples[i]);
+		result = (result < sample) ? sample : result;
+	}
+	return result;
+}
+
+} // namespace
+
 class FFMpegWaveformCounter : public FFMpegLoader {
 public:
 	FFMpegWaveformCounter(const Core::FileLocation &file, const QByteArray &data) : FFMpegLoader(file, data, bytes::vector()) {
@@ -1543,8 +1620,6 @@ public:
 			return false;
 		}
 
-		QByteArray buffer;
-		buffer.reserve(kWaveformCounterBufferSize);
 		const auto samplesCount = samplesFrequency() * duration() / 1000;
 		int64 countbytes = sampleSize() * samplesCount;
 		int64 processed = 0;
@@ -1558,13 +1633,24 @@ public:
 
 		auto fmt = format();
 		auto peak = uint16(0);
-		auto callback = [&](uint16 sample) {
-			accumulate_max(peak, sample);
-			sumbytes += Media::Player::kWaveformSamplesCount;
-			if (sumbytes >= countbytes) {
-				sumbytes -= countbytes;
-				peaks.push_back(peak);
-				peak = 0;
+
+		// Each sample adds kWaveformSamplesCount to sumbytes and a peak is
+		// finished when sumbytes reaches countbytes, so whole runs of
+		// samples between finished peaks are reduced at once.
+		const auto step = int64(Media::Player::kWaveformSamplesCount);
+		const auto feed = [&](const auto *samples, int64 count) {
+			while (count > 0) {
+				const auto left = (countbytes - sumbytes + step - 1) / step;
+				const auto take = std::min(count, std::max(left, int64(1)));
+				accumulate_max(peak, SamplesPeak(samples, take));
+				sumbytes += take * step;
+				if (sumbytes >= countbytes) {
+					sumbytes -= countbytes;
+					peaks.push_back(peak);
+					peak = 0;
+				}
+				samples += take;
+				count -= take;
 			}
 		};
 		while (processed < countbytes) {
@@ -1580,9 +1666,13 @@ public:
 			const auto sampleBytes = v::get<bytes::const_span>(result);
 			Assert(!sampleBytes.empty());
 			if (fmt == AL_FORMAT_MONO8 || fmt == AL_FORMAT_STEREO8) {
-				Media::Audio::IterateSamples<uchar>(sampleBytes, callback);
+				feed(
+					reinterpret_cast<const uchar*>(sampleBytes.data()),
+					int64(sampleBytes.size()));
 			} else if (fmt == AL_FORMAT_MONO16 || fmt == AL_FORMAT_STEREO16) {
-				Media::Audio::IterateSamples<int16>(sampleBytes, callback);
+				feed(
+					reinterpret_cast<const int16*>(sampleBytes.data()),
+					int64(sampleBytes.size() / sizeof(int16)));
 			}
 			processed += sampleBytes.size();
 		}
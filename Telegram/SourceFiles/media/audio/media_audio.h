@@ -158,6 +158,7 @@ public:
 	// Thread: Main. Locks: AudioMutex.
 	void setSpeedFromExternal(const AudioMsgId &audioId, float64 speed);
 
+	// Thread: Any. Doesn't lock AudioMutex.
 	Streaming::TimePoint getExternalSyncTimePoint(
 		const AudioMsgId &audio) const;
 	crl::time getExternalCorrectedTime(
@@ -209,6 +210,23 @@ private:
 	public:
 		static constexpr int kBuffersCount = 3;
 
+		// Written under AudioMutex, read without any locking (seqlock),
+		// so that the video sync doesn't wait for the fader or loaders.
+		class ExternalSyncPoint final {
+		public:
+			void set(uint32 playId, crl::time position, crl::time when);
+			void reset();
+
+			[[nodiscard]] Streaming::TimePoint get(uint32 playId) const;
+
+		private:
+			std::atomic<uint32> _version = 0;
+			std::atomic<uint32> _playId = 0;
+			std::atomic<crl::time> _position = 0;
+			std::atomic<crl::time> _when = 0;
+
+		};
+
 		// Thread: Any. Must be locked: AudioMutex.
 		void reattach(AudioMsgId::Type type);
 
@@ -271,8 +289,7 @@ private:
 
 		std::unique_ptr<ExternalSoundData> externalData;
 
-		crl::time lastUpdateWhen = 0;
-		crl::time lastUpdatePosition = 0;
+		ExternalSyncPoint externalSyncPoint;
 
 	private:
 		void createStream(AudioMsgId::Type type);
@@ -286,6 +303,8 @@ private:
 	bool checkCurrentALError(AudioMsgId::Type type);
 
 	void externalSoundProgress(const AudioMsgId &audio);
+	[[nodiscard]] Streaming::TimePoint externalSyncPoint(
+		const AudioMsgId &audio) const;
 
 	// Thread: Any. Must be locked: AudioMutex.
 	void setStoppedState(Track *current, State state = State::Stopped);
@@ -147,6 +147,8 @@ private:
 	ReaderPointers::iterator unsafeFindReaderPointer(ReaderPrivate *reader);
 
 	bool handleProcessResult(ReaderPrivate *reader, ProcessResult result, crl::time ms);
+	[[nodiscard]] static int ReaderLoadLevel(not_null<ReaderPrivate*> reader);
+	void removeReader(ReaderPrivate *reader);
 
 	enum ResultHandleState {
 		ResultHandleRemove,
@@ -792,6 +794,8 @@ bool Manager::handleProcessResult(ReaderPrivate *reader, ProcessResult result, c
 		Assert(previous != nullptr && showing != nullptr && ishowing >= 0 && iprevious >= 0);
 		if (reader->_frames[ishowing].when > 0 && showing->displayed.loadAcquire() <= 0) { // current frame was not shown
 			if (reader->_frames[ishowing].when + kWaitBeforeGifPause < ms || (reader->_frames[iprevious].when && previous->displayed.loadAcquire() <= 0)) {
+				// Auto paused GIFs don't load the thread until resumed.
+				_loadLevel.fetchAndAddRelaxed(-ReaderLoadLevel(reader));
 				reader->_autoPausedGif = true;
 				it.key()->_autoPausedGif.storeRelease(1);
 				result = ProcessResult::Paused;
@@ -825,8 +829,7 @@ bool Manager::handleProcessResult(ReaderPrivate *reader, ProcessResult result, c
 
 Manager::ResultHandleState Manager::handleResult(ReaderPrivate *reader, ProcessResult result, crl::time ms) {
 	if (!handleProcessResult(reader, result, ms)) {
-		_loadLevel.fetchAndAddRelaxed(-1 * (reader->_width > 0 ? reader->_width * reader->_height : kAverageGifSize));
-		delete reader;
+		removeReader(reader);
 		return ResultHandleRemove;
 	}
 
@@ -878,6 +881,7 @@ void Manager::process() {
 					i.value() = ms;
 					if (i.key()->_autoPausedGif && !it.key()->_autoPausedGif.loadAcquire()) {
 						i.key()->_autoPausedGif = false;
+						_loadLevel.fetchAndAddRelaxed(ReaderLoadLevel(i.key()));
 					}
 					if (it.key()->_videoPauseRequest.loadAcquire()) {
 						i.key()->pauseVideo(ms);
@@ -893,39 +897,48 @@ void Manager::process() {
 		checkAllReaders = (_readers.size() > _readerPointers.size());
 	}
 
+	// Decode the frames that are late the most first, so that a heavy
+	// reader doesn't make all the following ones miss their deadlines.
+	auto due = std::vector<std::pair<crl::time, ReaderPrivate*>>();
 	for (auto i = _readers.begin(), e = _readers.end(); i != e;) {
-		ReaderPrivate *reader = i.key();
+		const auto reader = i.key();
 		if (i.value() <= ms) {
-			ResultHandleState state = handleResult(reader, reader->process(ms), ms);
-			if (state == ResultHandleRemove) {
-				i = _readers.erase(i);
-				continue;
-			} else if (state == ResultHandleStop) {
-				_processingInThread = nullptr;
-				return;
-			}
-			ms = crl::now();
-			if (reader->_videoPausedAtMs) {
-				i.value() = ms + 86400 * 1000ULL;
-			} else if (reader->_nextFrameWhen && reader->_started) {
-				i.value() = reader->_nextFrameWhen;
-			} else {
-				i.value() = (ms + 86400 * 1000ULL);
-			}
+			due.emplace_back(i.value(), reader);
 		} else if (checkAllReaders) {
 			QMutexLocker lock(&_readerPointersMutex);
 			auto it = constUnsafeFindReaderPointer(reader);
 			if (it == _readerPointers.cend()) {
-				_loadLevel.fetchAndAddRelaxed(-1 * (reader->_width > 0 ? reader->_width * reader->_height : kAverageGifSize));
-				delete reader;
+				removeReader(reader);
 				i = _readers.erase(i);
 				continue;
 			}
 		}
-		if (!reader->_autoPausedGif && i.value() < minms) {
+		++i;
+	}
+	ranges::sort(due);
+
+	for (const auto &[when, reader] : due) {
+		const auto state = handleResult(reader, reader->process(ms), ms);
+		if (state == ResultHandleRemove) {
+			_readers.remove(reader);
+			continue;
+		} else if (state == ResultHandleStop) {
+			_processingInThread = nullptr;
+			return;
+		}
+		ms = crl::now();
+		if (reader->_videoPausedAtMs) {
+			_readers[reader] = ms + 86400 * 1000ULL;
+		} else if (reader->_nextFrameWhen && reader->_started) {
+			_readers[reader] = reader->_nextFrameWhen;
+		} else {
+			_readers[reader] = (ms + 86400 * 1000ULL);
+		}
+	}
+	for (auto i = _readers.cbegin(), e = _readers.cend(); i != e; ++i) {
+		if (!i.key()->_autoPausedGif && i.value() < minms) {
 			minms = i.value();
 		}
-		++i;
 	}
 
 	ms = crl::now();
@@ -939,6 +952,19 @@ void Manager::process() {
 	_processingInThread = nullptr;
 }
 
+int Manager::ReaderLoadLevel(not_null<ReaderPrivate*> reader) {
+	return reader->_autoPausedGif
+		? 0
+		: (reader->_width > 0)
+		? (reader->_width * reader->_height)
+		: kAverageGifSize;
+}
+
+void Manager::removeReader(ReaderPrivate *reader) {
+	_loadLevel.fetchAndAddRelaxed(-ReaderLoadLevel(reader));
+	delete reader;
+}
+
 void Manager::finish() {
 	_timer.stop();
 	clear();
@@ -23,8 +23,17 @@ constexpr auto kMaxOnlyInHeader = 80 * kPartSize;
 constexpr auto kPartsOutsideFirstSliceGood = 8;
 constexpr auto kSlicesInMemory = 2;
 
-// 1 MB of parts are requested from cloud ahead of reading demand.
-constexpr auto kPreloadPartsAhead = 8;
+// From 1 MB to 4 MB of parts are requested from cloud ahead of reading
+// demand. Each second the window is sized to cover kPreloadAheadTime of
+// the measured sequential reading and it is doubled if reading had to wait
+// for the cloud while downloading didn't stay well ahead of the reading.
+// It shrinks back only after a few seconds of reads without waiting.
+constexpr auto kPreloadPartsAheadMin = 8;
+constexpr auto kPreloadPartsAheadMax = 32;
+constexpr auto kPreloadAheadTime = crl::time(2000);
+constexpr auto kPrefetchMeasureTime = crl::time(1000);
+constexpr auto kDownloadAheadRatio = 2;
+constexpr auto kShrinkPreloadAfterCalmMeasures = 5;
 constexpr auto kDownloaderRequestsLimit = 4;
 
 using PartsMap = base::flat_map<uint32, QByteArray>;
@@ -270,13 +279,14 @@ void Reader::Slice::addPart(uint32 offset, QByteArray bytes) {
 
 auto Reader::Slice::prepareFill(
 		uint32 from,
-		uint32 till) -> PrepareFillResult {
+		uint32 till,
+		int preloadParts) -> PrepareFillResult {
 	auto result = PrepareFillResult();
 
 	result.ready = false;
 	const auto fromOffset = (from / kPartSize) * kPartSize;
 	const auto tillPart = (till + kPartSize - 1) / kPartSize;
-	const auto preloadTillOffset = (tillPart + kPreloadPartsAhead)
+	const auto preloadTillOffset = (tillPart + preloadParts)
 		* kPartSize;
 
 	const auto after = ranges::upper_bound(
@@ -287,7 +297,8 @@ auto Reader::Slice::prepareFill(
 	if (after == begin(parts)) {
 		result.offsetsFromLoader = offsetsFromLoader(
 			fromOffset,
-			preloadTillOffset);
+			preloadTillOffset,
+			preloadParts);
 		return result;
 	}
 
@@ -304,7 +315,8 @@ auto Reader::Slice::prepareFill(
 	if (haveTill < till) {
 		result.offsetsFromLoader = offsetsFromLoader(
 			haveTill,
-			preloadTillOffset);
+			preloadTillOffset,
+			preloadParts);
 		return result;
 	}
 	result.ready = true;
@@ -312,13 +324,19 @@ auto Reader::Slice::prepareFill(
 	result.finish = finish;
 	result.offsetsFromLoader = offsetsFromLoader(
 		tillPart * kPartSize,
-		preloadTillOffset);
+		preloadTillOffset,
+		preloadParts);
 	return result;
 }
 
-auto Reader::Slice::offsetsFromLoader(uint32 from, uint32 till) const
--> StackIntVector<Reader::kLoadFromRemoteMax> {
+auto Reader::Slice::offsetsFromLoader(
+		uint32 from,
+		uint32 till,
+		int limit) const -> StackIntVector<Reader::kLoadFromRemoteMax> {
+	Expects(limit > 0 && limit <= kLoadFromRemoteMax);
+
 	auto result = StackIntVector<kLoadFromRemoteMax>();
+	auto added = 0;
 
 	const auto after = ranges::upper_bound(
 		parts,
@@ -333,7 +351,7 @@ auto Reader::Slice::offsetsFromLoader(uint32 from, uint32 till) const
 		}
 		if (check != end && check->first == offset) {
 			continue;
-		} else if (!result.add(offset)) {
+		} else if (added++ == limit || !result.add(offset)) {
 			break;
 		}
 	}
@@ -548,7 +566,10 @@ void Reader::Slices::processPart(
 	checkSliceFullLoaded(index + 1);
 }
 
-auto Reader::Slices::fill(uint32 offset, bytes::span buffer) -> FillResult {
+auto Reader::Slices::fill(
+		uint32 offset,
+		bytes::span buffer,
+		int preloadParts) -> FillResult {
 	Expects(!buffer.empty());
 	Expects(offset < _size);
 	Expects(offset + buffer.size() <= _size);
@@ -562,7 +583,7 @@ auto Reader::Slices::fill(uint32 offset, bytes::span buffer) -> FillResult {
 		Assert(waitingForHeaderCache());
 		return {};
 	} else if (isFullInHeader()) {
-		return fillFromHeader(offset, buffer);
+		return fillFromHeader(offset, buffer, preloadParts);
 	}
 
 	auto result = FillResult();
@@ -605,9 +626,15 @@ auto Reader::Slices::fill(uint32 offset, bytes::span buffer) -> FillResult {
 	const auto secondTill = (till > (fromSlice + 1) * kInSlice)
 		? (till - (fromSlice + 1) * kInSlice)
 		: 0;
-	const auto first = _data[fromSlice].prepareFill(firstFrom, firstTill);
+	const auto first = _data[fromSlice].prepareFill(
+		firstFrom,
+		firstTill,
+		preloadParts);
 	const auto second = (fromSlice + 1 < tillSlice)
-		? _data[fromSlice + 1].prepareFill(secondFrom, secondTill)
+		? _data[fromSlice + 1].prepareFill(
+			secondFrom,
+			secondTill,
+			preloadParts)
 		: Slice::PrepareFillResult();
 	handlePrepareResult(fromSlice, first);
 	if (fromSlice + 1 < tillSlice) {
@@ -639,13 +666,15 @@ auto Reader::Slices::fill(uint32 offset, bytes::span buffer) -> FillResult {
 	return result;
 }
 
-auto Reader::Slices::fillFromHeader(uint32 offset, bytes::span buffer)
--> FillResult {
+auto Reader::Slices::fillFromHeader(
+		uint32 offset,
+		bytes::span buffer,
+		int preloadParts) -> FillResult {
 	auto result = FillResult();
 	const auto from = offset;
 	const auto till = uint32(offset + buffer.size());
 
-	const auto prepared = _header.prepareFill(from, till);
+	const auto prepared = _header.prepareFill(from, till, preloadParts);
 	for (const auto full : prepared.offsetsFromLoader.values()) {
 		if (full < _size) {
 			result.offsetsFromLoader.add(full);
@@ -838,20 +867,78 @@ Reader::SerializedSlice Reader::Slices::unloadToCache() {
 	return {};
 }
 
+void Reader::LoadedPartsQueue::push(LoadedPart &&part) {
+	const auto tail = _tail.load(std::memory_order_relaxed);
+	if (_overflowing.load(std::memory_order_relaxed)
+		|| tail - _head.load(std::memory_order_acquire) == kSlots) {
+		QMutexLocker lock(&_overflowMutex);
+		_overflow.push_back(std::move(part));
+		_overflowing.store(true, std::memory_order_release);
+		return;
+	}
+	_slots[tail % kSlots] = std::move(part);
+	_tail.store(tail + 1, std::memory_order_release);
+}
+
+template <typename Callback>
+bool Reader::LoadedPartsQueue::consume(Callback &&callback) {
+	auto result = false;
+	const auto tail = _tail.load(std::memory_order_acquire);
+	for (auto head = _head.load(std::memory_order_relaxed)
+		; head != tail
+		; ++head) {
+		auto part = std::move(_slots[head % kSlots]);
+		_head.store(head + 1, std::memory_order_release);
+		result = true;
+		if (!callback(std::move(part))) {
+			return result;
+		}
+	}
+	if (!_overflowing.load(std::memory_order_acquire)) {
+		return result;
+	}
+	auto overflow = std::vector<LoadedPart>();
+	{
+		QMutexLocker lock(&_overflowMutex);
+
+		// While overflowing nothing is pushed to the ring, so the parts
+		// still left there were pushed before the overflow ones.
+		const auto tail = _tail.load(std::memory_order_acquire);
+		auto head = _head.load(std::memory_order_relaxed);
+		overflow.reserve((tail - head) + _overflow.size());
+		for (; head != tail; ++head) {
+			overflow.push_back(std::move(_slots[head % kSlots]));
+		}
+		_head.store(tail, std::memory_order_release);
+		for (auto &part : base::take(_overflow)) {
+			overflow.push_back(std::move(part));
+		}
+		_overflowing.store(false, std::memory_order_release);
+	}
+	for (auto &part : overflow) {
+		result = true;
+		if (!callback(std::move(part))) {
+			return result;
+		}
+	}
+	return result;
+}
+
 Reader::Reader(
 	std::unique_ptr<Loader> loader,
 	Storage::Cache::Database *cache)
 : _loader(std::move(loader))
 , _cache(cache)
 , _cacheHelper(cache ? InitCacheHelper(_loader->baseCacheKey()) : nullptr)
-, _slices(_loader->size(), _cacheHelper != nullptr) {
+, _slices(_loader->size(), _cacheHelper != nullptr)
+, _preloadParts(kPreloadPartsAheadMin) {
 	_loader->parts(
 	) | rpl::start_with_next([=](LoadedPart &&part) {
 		if (_attachedDownloader) {
 			_partsForDownloader.fire_copy(part);
 		}
 		if (_streamingActive) {
-			_loadedParts.emplace(std::move(part));
+			_loadedParts.push(std::move(part));
 		}
 		if (const auto waiting = _waiting.load(std::memory_order_acquire)) {
 			_waiting.store(nullptr, std::memory_order_release);
@@ -1248,21 +1335,28 @@ Reader::FillState Reader::fill(
 	}
 
 	auto lastResult = FillState();
+	auto waitedRemote = false;
 	do {
 		lastResult = fillFromSlices(uint32(offset), buffer);
 		if (lastResult == FillState::Success) {
+			updatePrefetch(uint32(offset), int(buffer.size()), waitedRemote);
 			return done();
+		} else if (lastResult == FillState::WaitingRemote) {
+			waitedRemote = true;
 		}
 		startWaiting();
 	} while (checkForSomethingMoreReceived());
 
+	// The read will be repeated, count the stall when it succeeds.
+	_waitedRemote = _waitedRemote || waitedRemote;
+
 	return _streamingError ? failed() : lastResult;
 }
 
 Reader::FillState Reader::fillFromSlices(uint32 offset, bytes::span buffer) {
 	using namespace rpl::mappers;
 
-	auto result = _slices.fill(offset, buffer);
+	auto result = _slices.fill(offset, buffer, _preloadParts);
 	if (result.state != FillState::Success && _slices.headerWontBeFilled()) {
 		_streamingError = Error::NotStreamable;
 		return FillState::Failed;
@@ -1292,6 +1386,87 @@ Reader::FillState Reader::fillFromSlices(uint32 offset, bytes::span buffer) {
 	return result.state;
 }
 
+void Reader::updatePrefetch(uint32 offset, int size, bool waitedRemote) {
+	// Seeks always wait for the cloud, whatever the prefetch window is,
+	// so only the stalls of the sequential reading are taken into account.
+	const auto sequential = (_lastReadTill >= 0)
+		&& (std::abs(int64(offset) - _lastReadTill) <= int64(kInSlice));
+	_lastReadTill = int64(offset) + size;
+	if (base::take(_waitedRemote) || waitedRemote) {
+		if (sequential) {
+			++_prefetchMeasure.remoteStalls;
+			++_prefetchTotals.remoteStalls;
+		} else {
+			++_prefetchTotals.seekStalls;
+		}
+	}
+	if (sequential) {
+		_prefetchMeasure.consumed += size;
+	}
+	const auto now = crl::now();
+	if (!_prefetchMeasure.started) {
+		_prefetchMeasure.started = now;
+	} else if (now - _prefetchMeasure.started >= kPrefetchMeasureTime) {
+		finishPrefetchMeasure(now);
+	}
+}
+
+void Reader::finishPrefetchMeasure(crl::time now) {
+	const auto measure = base::take(_prefetchMeasure);
+	_prefetchMeasure.started = now;
+	if (!measure.consumed) {
+		// Only seeks, nothing to measure.
+		return;
+	}
+	const auto passed = now - measure.started;
+	const auto consumedPerSecond = measure.consumed * 1000 / passed;
+	const auto downloadedPerSecond = measure.downloaded * 1000 / passed;
+	const auto byBitrate = int(
+		(consumedPerSecond * kPreloadAheadTime / 1000 + kPartSize - 1)
+			/ kPartSize);
+	const auto downloadBehind = (downloadedPerSecond
+		< consumedPerSecond * kDownloadAheadRatio);
+
+	const auto was = _preloadParts;
+	auto wanted = std::max(_preloadParts, byBitrate);
+	if (measure.remoteStalls) {
+		_preloadCalmMeasures = 0;
+		if (downloadBehind) {
+			wanted = std::max(_preloadParts * 2, byBitrate);
+		}
+	} else if (++_preloadCalmMeasures >= kShrinkPreloadAfterCalmMeasures) {
+		_preloadCalmMeasures = 0;
+		wanted = std::max(_preloadParts / 2, byBitrate);
+	}
+	_preloadParts = std::clamp(
+		wanted,
+		kPreloadPartsAheadMin,
+		kPreloadPartsAheadMax);
+
+	_prefetchTotals.preloadParts = _preloadParts;
+	_prefetchTotals.consumedPerSecond = consumedPerSecond;
+	_prefetchTotals.downloadedPerSecond = downloadedPerSecond;
+	{
+		QMutexLocker lock(&_prefetchStatsMutex);
+		_prefetchStats = _prefetchTotals;
+	}
+	if (_preloadParts != was) {
+		DEBUG_LOG(("Streaming Info: Preload %1 parts ahead, "
+			"reading %2 bytes/s, downloading %3 bytes/s, "
+			"%4 stalls in the last %5ms."
+			).arg(_preloadParts
+			).arg(consumedPerSecond
+			).arg(downloadedPerSecond
+			).arg(measure.remoteStalls
+			).arg(passed));
+	}
+}
+
+Reader::PrefetchStats Reader::prefetchStats() const {
+	QMutexLocker lock(&_prefetchStatsMutex);
+	return _prefetchStats;
+}
+
 void Reader::cancelLoadInRange(uint32 from, uint32 till) {
 	Expects(from < till);
 
@@ -1351,19 +1526,19 @@ bool Reader::processLoadedParts() {
 		return false;
 	}
 
-	auto loaded = _loadedParts.take();
-	for (auto &part : loaded) {
+	return _loadedParts.consume([&](LoadedPart &&part) {
 		if (!part.valid(size())) {
 			_streamingError = Error::LoadFailed;
 			return false;
-		} else if (!_loadingOffsets.remove(part.offset)) {
-			continue;
 		}
-		_slices.processPart(
-			part.offset,
-			std::move(part.bytes));
-	}
-	return !loaded.empty();
+		_prefetchMeasure.downloaded += part.bytes.size();
+		if (_loadingOffsets.remove(part.offset)) {
+			_slices.processPart(
+				part.offset,
+				std::move(part.bytes));
+		}
+		return true;
+	}) && !_streamingError;
 }
 
 bool Reader::checkForSomethingMoreReceived() {
@@ -60,7 +60,17 @@ public:
 	[[nodiscard]] int headerSize() const;
 	[[nodiscard]] bool fullInCache() const;
 
+	// Decisions of the prefetch window controller, for debugging.
+	struct PrefetchStats {
+		int preloadParts = 0;
+		int64 consumedPerSecond = 0;
+		int64 downloadedPerSecond = 0;
+		int remoteStalls = 0;
+		int seekStalls = 0;
+	};
+
 	// Thread safe.
+	[[nodiscard]] PrefetchStats prefetchStats() const;
 	void startSleep(not_null<crl::semaphore*> wake);
 	void wakeFromSleep();
 	void stopSleep();
@@ -82,7 +92,7 @@ public:
 	~Reader();
 
 private:
-	static constexpr auto kLoadFromRemoteMax = 8;
+	static constexpr auto kLoadFromRemoteMax = 32;
 
 	struct CacheHelper;
 
@@ -132,12 +142,16 @@ private:
 
 		void processCacheData(PartsMap &&data);
 		void addPart(uint32 offset, QByteArray bytes);
-		PrepareFillResult prepareFill(uint32 from, uint32 till);
+		PrepareFillResult prepareFill(
+			uint32 from,
+			uint32 till,
+			int preloadParts);
 
-		// Get up to kLoadFromRemoteMax not loaded parts in from-till range.
+		// Get up to limit not loaded parts in from-till range.
 		StackIntVector<kLoadFromRemoteMax> offsetsFromLoader(
 			uint32 from,
-			uint32 till) const;
+			uint32 till,
+			int limit) const;
 
 		PartsMap parts;
 		Flags flags;
@@ -163,7 +177,10 @@ private:
 		void processCachedSizes(const std::vector<int> &sizes);
 		void processPart(uint32 offset, QByteArray &&bytes);
 
-		[[nodiscard]] FillResult fill(uint32 offset, bytes::span buffer);
+		[[nodiscard]] FillResult fill(
+			uint32 offset,
+			bytes::span buffer,
+			int preloadParts);
 		[[nodiscard]] SerializedSlice unloadToCache();
 
 		[[nodiscard]] QByteArray partForDownloader(uint32 offset) const;
@@ -190,7 +207,8 @@ private:
 		[[nodiscard]] bool computeIsGoodHeader() const;
 		[[nodiscard]] FillResult fillFromHeader(
 			uint32 offset,
-			bytes::span buffer);
+			bytes::span buffer,
+			int preloadParts);
 		void unloadSlice(Slice &slice) const;
 		void checkSliceFullLoaded(int sliceNumber);
 		[[nodiscard]] bool checkFullInCache() const;
@@ -204,6 +222,30 @@ private:
 
 	};
 
+	// Lock-free single producer (main thread) single consumer (streaming
+	// thread) queue of the loaded parts with preallocated slots.
+	// If the consumer falls behind, the rest is queued in a locked list
+	// and the ring isn't used until the consumer takes the whole list.
+	class LoadedPartsQueue final {
+	public:
+		void push(LoadedPart &&part);
+
+		// Callback returns false to stop consuming.
+		template <typename Callback>
+		bool consume(Callback &&callback);
+
+	private:
+		static constexpr auto kSlots = 64;
+
+		std::array<LoadedPart, kSlots> _slots;
+		std::atomic<uint32> _head = 0;
+		std::atomic<uint32> _tail = 0;
+		QMutex _overflowMutex;
+		std::vector<LoadedPart> _overflow;
+		std::atomic<bool> _overflowing = false;
+
+	};
+
 	// 0 is for headerData, slice index = sliceNumber - 1.
 	// returns false if asked for a known-empty downloader slice cache.
 	void readFromCache(int sliceNumber);
@@ -219,6 +261,8 @@ private:
 	bool checkForSomethingMoreReceived();
 
 	FillState fillFromSlices(uint32 offset, bytes::span buffer);
+	void updatePrefetch(uint32 offset, int size, bool waitedRemote);
+	void finishPrefetchMeasure(crl::time now);
 
 	void finalizeCache();
 
@@ -243,7 +287,7 @@ private:
 	// shared_ptr is used to be able to have weak_ptr.
 	const std::shared_ptr<CacheHelper> _cacheHelper;
 
-	base::thread_safe_queue<LoadedPart, std::vector> _loadedParts;
+	LoadedPartsQueue _loadedParts;
 	std::atomic<crl::semaphore*> _waiting = nullptr;
 	std::atomic<crl::semaphore*> _sleeping = nullptr;
 	std::atomic<bool> _stopStreamingAsync = false;
@@ -264,6 +308,18 @@ private:
 	bool _streamingActive = false;
 
 	// Streaming thread.
+	struct PrefetchMeasure {
+		crl::time started = 0;
+		int64 consumed = 0;
+		int64 downloaded = 0;
+		int remoteStalls = 0;
+	};
+	int _preloadParts = 0;
+	int _preloadCalmMeasures = 0;
+	int64 _lastReadTill = -1;
+	bool _waitedRemote = false;
+	PrefetchMeasure _prefetchMeasure;
+	PrefetchStats _prefetchTotals;
 	std::deque<uint32> _offsetsForDownloader;
 	base::flat_set<uint32> _downloaderOffsetsRequested;
 	base::flat_map<uint32, std::optional<PartsMap>> _downloaderReadCache;
@@ -273,6 +329,10 @@ private:
 	base::thread_safe_queue<uint32> _downloaderOffsetRequests;
 	base::thread_safe_queue<uint32> _downloaderOffsetAcks;
 
+	// Published by the streaming thread once per prefetch measure.
+	mutable QMutex _prefetchStatsMutex;
+	PrefetchStats _prefetchStats;
+
 	rpl::lifetime _lifetime;
 
 };
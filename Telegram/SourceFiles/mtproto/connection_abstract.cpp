@@ -20,6 +20,9 @@ namespace {
 
 std::atomic<int> GlobalConnectionCounter/* = 0*/;
 
+constexpr auto kReceiveBuffersPoolSize = 8;
+constexpr auto kReceiveBufferMaxPooledInts = 256 * 1024;
+
 } // namespace
 
 ConnectionPointer::ConnectionPointer() = default;
@@ -82,6 +85,24 @@ ConnectionPointer::~ConnectionPointer() {
 	reset();
 }
 
+void AbstractConnection::releaseReceivedBuffer(mtpBuffer &&buffer) {
+	if (_receiveBuffersPool.size() >= kReceiveBuffersPoolSize
+		|| buffer.capacity() > kReceiveBufferMaxPooledInts) {
+		return;
+	}
+	_receiveBuffersPool.push_back(std::move(buffer));
+}
+
+mtpBuffer AbstractConnection::takeReceiveBuffer(int size) {
+	auto result = mtpBuffer();
+	if (!_receiveBuffersPool.empty()) {
+		result = std::move(_receiveBuffersPool.back());
+		_receiveBuffersPool.pop_back();
+	}
+	result.resize(size);
+	return result;
+}
+
 mtpBuffer AbstractConnection::prepareSecurePacket(
 		uint64 keyId,
 		MTPint128 msgKey,
@@ -114,6 +114,10 @@ public:
 		return _receivedQueue;
 	}
 
+	// Buffers taken from received() may be returned here after handling,
+	// so that steady-state receiving reuses their allocations.
+	void releaseReceivedBuffer(mtpBuffer &&buffer);
+
 	template <typename Request>
 	[[nodiscard]] mtpBuffer prepareNotSecurePacket(
 		const Request &request,
@@ -156,6 +160,8 @@ protected:
 
 	// first we always send fake MTPReq_pq to see if connection works at all
 	// we send them simultaneously through TCP/HTTP/IPv4/IPv6 to choose the working one
+	[[nodiscard]] mtpBuffer takeReceiveBuffer(int size);
+
 	[[nodiscard]] mtpBuffer preparePQFake(const MTPint128 &nonce) const;
 	[[nodiscard]] std::optional<MTPResPQ> readPQFakeReply(
 		const mtpBuffer &buffer) const;
@@ -164,6 +170,7 @@ private:
 	[[nodiscard]] uint32 extendedNotSecurePadding() const;
 
 	uint64 _sentEncryptedWithKeyId = 0;
+	std::vector<mtpBuffer> _receiveBuffersPool;
 
 };
 
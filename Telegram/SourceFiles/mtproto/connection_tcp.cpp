@@ -401,9 +401,11 @@ mtpBuffer TcpConnection::parsePacket(bytes::const_span bytes) {
 			CONNECTION_LOG_ERROR(u"Error packet received, code = %1"_q
 				.arg(ints[0]));
 		}
-		return mtpBuffer(1, ints[0]);
+		auto result = takeReceiveBuffer(1);
+		result[0] = ints[0];
+		return result;
 	}
-	auto result = mtpBuffer(ints.size());
+	auto result = takeReceiveBuffer(ints.size());
 	memcpy(result.data(), ints.data(), ints.size() * sizeof(mtpPrime));
 	return result;
 }
@@ -586,17 +588,19 @@ void TcpConnection::socketPacket(bytes::const_span bytes) {
 	Expects(_socket != nullptr);
 
 	// old quickack?..
-	const auto data = parsePacket(bytes);
+	auto data = parsePacket(bytes);
 	if (data.size() == 1) {
-		if (data[0] != 0) {
-			error(data[0]);
+		const auto code = data[0];
+		releaseReceivedBuffer(std::move(data));
+		if (code != 0) {
+			error(code);
 		} else {
 			// nop
 		}
 	//} else if (data.size() == 2) {
 		// new quickack?..
 	} else if (_status == Status::Ready) {
-		_receivedQueue.push_back(data);
+		_receivedQueue.push_back(std::move(data));
 		receivedData();
 	} else if (_status == Status::Waiting) {
 		if (const auto res_pq = readPQFakeReply(data)) {
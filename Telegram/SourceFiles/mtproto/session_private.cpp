@@ -64,6 +64,10 @@ constexpr auto kAckSendWaiting = 10 * crl::time(1000);
 
 constexpr auto kCutContainerOnSize = 16 * 1024;
 
+// Keep a few gzip unpacking buffers to reuse them for the next responses.
+constexpr auto kUnpackedBuffersPoolSize = 4;
+constexpr auto kUnpackedBufferMaxPooledInts = 256 * 1024;
+
 auto SyncTimeRequestDuration = kFastRequestDuration;
 
 using namespace details;
@@ -1292,7 +1296,8 @@ void SessionPrivate::handleReceived() {
 		auto encryptedInts = ints + kExternalHeaderIntsCount;
 		auto encryptedIntsCount = (intsCount - kExternalHeaderIntsCount) & ~0x03U;
 		auto encryptedBytesCount = encryptedIntsCount * kIntSize;
-		auto decryptedBuffer = QByteArray(encryptedBytesCount, Qt::Uninitialized);
+		auto decryptedBuffer = base::take(_receivedDecrypted);
+		decryptedBuffer.resize(encryptedBytesCount);
 		auto msgKey = *(MTPint128*)(ints + 2);
 
 		aesIgeDecrypt(encryptedInts, decryptedBuffer.data(), encryptedBytesCount, _encryptionKey, msgKey);
@@ -1434,6 +1439,9 @@ void SessionPrivate::handleReceived() {
 				_sessionData->queueNeedToResumeAndSend();
 			}
 		}
+
+		_receivedDecrypted = std::move(decryptedBuffer);
+		_connection->releaseReceivedBuffer(std::move(intsBuffer));
 	}
 	if (_connection->needHttpWait()) {
 		_sessionData->queueSendAnything();
@@ -1451,11 +1459,24 @@ SessionPrivate::HandleResult SessionPrivate::handleOneReceived(
 
 	case mtpc_gzip_packed: {
 		DEBUG_LOG(("Message Info: gzip container"));
-		mtpBuffer response = ungzip(++from, end);
-		if (response.empty()) {
+		auto response = mtpBuffer();
+		if (!_unpackedBuffers.empty()) {
+			response = std::move(_unpackedBuffers.back());
+			_unpackedBuffers.pop_back();
+		}
+		if (!ungzip(++from, end, response)) {
 			return HandleResult::RestartConnection;
 		}
-		return handleOneReceived(response.data(), response.data() + response.size(), msgId, info);
+		const auto result = handleOneReceived(
+			response.constData(),
+			response.constData() + response.size(),
+			msgId,
+			info);
+		if (_unpackedBuffers.size() < kUnpackedBuffersPoolSize
+			&& response.capacity() <= kUnpackedBufferMaxPooledInts) {
+			_unpackedBuffers.push_back(std::move(response));
+		}
+		return result;
 	}
 
 	case mtpc_msg_container: {
@@ -2011,16 +2032,19 @@ SessionPrivate::HandleResult SessionPrivate::handleBindResponse(
 	Unexpected("Result of BoundKeyCreator::handleBindResponse.");
 }
 
-mtpBuffer SessionPrivate::ungzip(const mtpPrime *from, const mtpPrime *end) const {
-	mtpBuffer result; // * 4 because of mtpPrime type
-	result.resize(0);
+bool SessionPrivate::ungzip(
+		const mtpPrime *from,
+		const mtpPrime *end,
+		mtpBuffer &result) const {
+	result.resize(0); // Keeps the capacity for the reused buffers.
 
 	MTPstring packed;
 	if (!packed.read(from, end)) { // read packed string as serialized mtp string type
 		LOG(("RPC Error: could not read gziped bytes."));
-		return result;
+		return false;
 	}
-	uint32 packedLen = packed.v.size(), unpackedChunk = packedLen;
+	const auto packedLen = uint32(packed.v.size());
+	const auto unpackedChunk = packedLen;
 
 	z_stream stream;
 	stream.zalloc = 0;
@@ -2031,7 +2055,7 @@ mtpBuffer SessionPrivate::ungzip(const mtpPrime *from, const mtpPrime *end) cons
 	int res = inflateInit2(&stream, 16 + MAX_WBITS);
 	if (res != Z_OK) {
 		LOG(("RPC Error: could not init zlib stream, code: %1").arg(res));
-		return result;
+		return false;
 	}
 	stream.avail_in = packedLen;
 	stream.next_in = reinterpret_cast<Bytef*>(packed.v.data());
@@ -2046,21 +2070,23 @@ mtpBuffer SessionPrivate::ungzip(const mtpPrime *from, const mtpPrime *end) cons
 			inflateEnd(&stream);
 			LOG(("RPC Error: could not unpack gziped data, code: %1").arg(res));
 			DEBUG_LOG(("RPC Error: bad gzip: %1").arg(Logs::mb(packed.v.constData(), packedLen).str()));
-			return mtpBuffer();
+			return false;
 		}
 	}
 	if (stream.avail_out & 0x03) {
 		uint32 badSize = result.size() * sizeof(mtpPrime) - stream.avail_out;
 		LOG(("RPC Error: bad length of unpacked data %1").arg(badSize));
 		DEBUG_LOG(("RPC Error: bad unpacked data %1").arg(Logs::mb(result.data(), badSize).str()));
-		return mtpBuffer();
+		inflateEnd(&stream);
+		return false;
 	}
 	result.resize(result.size() - (stream.avail_out >> 2));
 	inflateEnd(&stream);
 	if (!result.size()) {
 		LOG(("RPC Error: bad length of unpacked data 0"));
+		return false;
 	}
-	return result;
+	return true;
 }
 
 bool SessionPrivate::requestsFixTimeSalt(const QVector<MTPlong> &ids, const OuterInfo &info) {
@@ -133,7 +133,10 @@ private:
 	[[nodiscard]] HandleResult handleBindResponse(
 		mtpMsgId requestMsgId,
 		const mtpBuffer &response);
-	mtpBuffer ungzip(const mtpPrime *from, const mtpPrime *end) const;
+	[[nodiscard]] bool ungzip(
+		const mtpPrime *from,
+		const mtpPrime *end,
+		mtpBuffer &result) const;
 	void handleMsgsStates(const QVector<MTPlong> &ids, const QByteArray &states);
 
 	// _sessionDataMutex must be locked for read.
@@ -229,6 +232,8 @@ private:
 	QVector<MTPlong> _resendRequestData;
 	base::flat_set<mtpMsgId> _stateRequestData;
 	ReceivedIdsManager _receivedMessageIds;
+	QByteArray _receivedDecrypted;
+	std::vector<mtpBuffer> _unpackedBuffers;
 	base::flat_map<mtpMsgId, mtpRequestId> _resendingIds;
 	base::flat_map<mtpMsgId, mtpRequestId> _ackedIds;
 	base::flat_map<mtpMsgId, SerializedRequest> _stateAndResendRequests;
@@ -11,6 +11,8 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 
 namespace Statistic {
 
+// Static range max / min queries over the chart values.
+// Implemented as a sparse table: O(n log n) to build, O(1) to query.
 class SegmentTree final {
 public:
 	SegmentTree() = default;
@@ -23,48 +25,18 @@ public:
 		return !empty();
 	}
 
-	[[nodiscard]] ChartValue rMaxQ(int from, int to);
-	[[nodiscard]] ChartValue rMinQ(int from, int to);
+	[[nodiscard]] ChartValue rMaxQ(int from, int to) const;
+	[[nodiscard]] ChartValue rMinQ(int from, int to) const;
 
 private:
-	struct Node final {
-		ChartValue sum = 0;
-		ChartValue max = 0;
-		ChartValue min = 0;
-
-		struct PendingVal {
-			[[nodiscard]] explicit operator bool() const {
-				return available;
-			}
-			ChartValue value = 0;
-			bool available = false;
-		};
-		PendingVal pendingVal;
-
-		int from = 0;
-		int to = 0;
-
-		[[nodiscard]] int size() {
-			return to - from + 1;
-		}
-	};
-
-	void build(ChartValue v, int from, int size);
-	void propagate(ChartValue v);
-	void change(Node &n, ChartValue value);
-
-	[[nodiscard]] ChartValue rMaxQ(ChartValue v, int from, int to);
-	[[nodiscard]] ChartValue rMinQ(ChartValue v, int from, int to);
-
-	[[nodiscard]] bool contains(int from1, int to1, int from2, int to2) const;
-	[[nodiscard]] bool intersects(
-		int from1,
-		int to1,
-		int from2,
-		int to2) const;
+	[[nodiscard]] static int Level(int length);
 
 	std::vector<ChartValue> _array;
-	std::vector<Node> _heap;
+
+	// Level k holds max / min of [i, i + 2^k) at [(k - 1) * size + i].
+	// Level 0 is the _array itself and is not stored.
+	std::vector<ChartValue> _max;
+	std::vector<ChartValue> _min;
 
 };
 
@@ -17,54 +17,257 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include <QtCore/QJsonValue>
 
 namespace Statistic {
+namespace {
 
-Data::StatisticalChart StatisticalChartFromJSON(const QByteArray &json) {
-	auto error = QJsonParseError{ 0, QJsonParseError::NoError };
-	const auto document = QJsonDocument::fromJson(json, &error);
-	if (error.error != QJsonParseError::NoError || !document.isObject()) {
-		LOG(("API Error: Bad stats graph json received."));
-		return {};
+// The graph json is mostly the "columns" array with thousands of numbers.
+// It is read in a single pass straight into the chart vectors, only the
+// small values of the other root keys are parsed with QJsonDocument.
+class Reader final {
+public:
+	explicit Reader(const QByteArray &json)
+	: _ptr(json.constData())
+	, _end(json.constData() + json.size()) {
 	}
-	const auto root = document.object();
-	const auto columns = root.value(u"columns"_q).toArray();
-	if (columns.empty()) {
-		LOG(("API Error: Empty columns list from stats graph received."));
-		return {};
+
+	[[nodiscard]] bool failed() const {
+		return _failed;
 	}
 
-	const auto hiddenLinesRaw = root.value(u"hidden"_q).toArray();
-	const auto hiddenLines = ranges::views::all(
-		hiddenLinesRaw
-	) | ranges::views::transform([](const auto &q) {
-		return q.toString();
-	}) | ranges::to_vector;
+	[[nodiscard]] bool consume(char c) {
+		skipSpaces();
+		if (_ptr != _end && *_ptr == c) {
+			++_ptr;
+			return true;
+		}
+		return false;
+	}
+	void expect(char c) {
+		if (!consume(c)) {
+			_failed = true;
+		}
+	}
+	[[nodiscard]] bool atEnd() {
+		skipSpaces();
+		return (_ptr == _end);
+	}
 
-	auto result = Data::StatisticalChart();
+	[[nodiscard]] QString readString();
+	[[nodiscard]] float64 readNumber();
+	[[nodiscard]] QJsonValue readJsonValue();
+	void skipValue();
+
+private:
+	void skipSpaces() {
+		while (_ptr != _end
+			&& (*_ptr == ' '
+				|| *_ptr == '\n'
+				|| *_ptr == '\r'
+				|| *_ptr == '\t')) {
+			++_ptr;
+		}
+	}
+	void skipString();
+
+	const char *_ptr = nullptr;
+	const char *_end = nullptr;
+	bool _failed = false;
+
+};
+
+void Reader::skipString() {
+	if (!consume('"')) {
+		_failed = true;
+		return;
+	}
+	while (_ptr != _end) {
+		if (*_ptr == '\\') {
+			if (++_ptr == _end) {
+				break;
+			}
+		} else if (*_ptr == '"') {
+			++_ptr;
+			return;
+		}
+		++_ptr;
+	}
+	_failed = true;
+}
+
+QString Reader::readString() {
+	skipSpaces();
+	const auto from = _ptr;
+	skipString();
+	if (_failed) {
+		return QString();
+	}
+	const auto length = int(_ptr - from);
+	if (!std::memchr(from, '\\', length)) {
+		return QString::fromUtf8(from + 1, length - 2);
+	}
+	// Let QJsonDocument handle escape sequences.
+	auto wrapped = QByteArray();
+	wrapped.reserve(length + 2);
+	wrapped.append('[').append(from, length).append(']');
+	return QJsonDocument::fromJson(wrapped).array().first().toString();
+}
+
+float64 Reader::readNumber() {
+	skipSpaces();
+	if (_ptr == _end) {
+		_failed = true;
+		return 0.;
+	} else if (*_ptr != '-' && (*_ptr < '0' || *_ptr > '9')) {
+		// The DOM based parsing used to read all other values as zero.
+		readJsonValue();
+		return 0.;
+	}
+	const auto from = _ptr;
+	const auto digits = [&] {
+		const auto start = _ptr;
+		while (_ptr != _end && *_ptr >= '0' && *_ptr <= '9') {
+			++_ptr;
+		}
+		return int(_ptr - start);
+	};
+	const auto negative = (*_ptr == '-');
+	if (negative) {
+		++_ptr;
+	}
+	const auto leadingZero = (_ptr != _end && *_ptr == '0');
+	const auto integerDigits = digits();
+	if (!integerDigits || (leadingZero && integerDigits > 1)) {
+		_failed = true;
+		return 0.;
+	}
+	auto integer = true;
+	if (_ptr != _end && *_ptr == '.') {
+		++_ptr;
+		integer = false;
+		if (!digits()) {
+			_failed = true;
+			return 0.;
+		}
+	}
+	if (_ptr != _end && (*_ptr == 'e' || *_ptr == 'E')) {
+		++_ptr;
+		integer = false;
+		if (_ptr != _end && (*_ptr == '+' || *_ptr == '-')) {
+			++_ptr;
+		}
+		if (!digits()) {
+			_failed = true;
+			return 0.;
+		}
+	}
+	if (integer && integerDigits <= 18) {
+		auto result = int64(0);
+		for (auto i = from + (negative ? 1 : 0); i != _ptr; ++i) {
+			result = result * 10 + (*i - '0');
+		}
+		return float64(negative ? -result : result);
+	}
+	auto ok = false;
+	const auto result = QByteArray::fromRawData(
+		from,
+		int(_ptr - from)).toDouble(&ok);
+	if (!ok) {
+		_failed = true;
+	}
+	return result;
+}
+
+void Reader::skipValue() {
+	skipSpaces();
+	if (_ptr == _end) {
+		_failed = true;
+		return;
+	} else if (*_ptr == '"') {
+		skipString();
+		return;
+	} else if (*_ptr != '{' && *_ptr != '[') {
+		while (_ptr != _end
+			&& *_ptr != ','
+			&& *_ptr != '}'
+			&& *_ptr != ']') {
+			++_ptr;
+		}
+		return;
+	}
+	auto depth = 0;
+	while (_ptr != _end) {
+		const auto c = *_ptr;
+		if (c == '"') {
+			skipString();
+			if (_failed) {
+				return;
+			}
+			continue;
+		} else if (c == '{' || c == '[') {
+			++depth;
+		} else if (c == '}' || c == ']') {
+			if (!--depth) {
+				++_ptr;
+				return;
+			}
+		}
+		++_ptr;
+	}
+	_failed = true;
+}
+
+QJsonValue Reader::readJsonValue() {
+	skipSpaces();
+	const auto from = _ptr;
+	skipValue();
+	if (_failed) {
+		return QJsonValue();
+	}
+	const auto length = int(_ptr - from);
+	auto wrapped = QByteArray();
+	wrapped.reserve(length + 2);
+	wrapped.append('[').append(from, length).append(']');
+	auto error = QJsonParseError{ 0, QJsonParseError::NoError };
+	const auto document = QJsonDocument::fromJson(wrapped, &error);
+	if (error.error != QJsonParseError::NoError) {
+		_failed = true;
+		return QJsonValue();
+	}
+	return document.array().first();
+}
+
+[[nodiscard]] bool ReadColumns(
+		Reader &reader,
+		Data::StatisticalChart &result) {
+	reader.expect('[');
+	if (reader.consume(']')) {
+		LOG(("API Error: Empty columns list from stats graph received."));
+		return false;
+	}
 	auto columnIdCount = 0;
-	for (const auto &column : columns) {
-		const auto array = column.toArray();
-		if (array.empty()) {
+	do {
+		reader.expect('[');
+		if (reader.failed()) {
+			return false;
+		} else if (reader.consume(']')) {
 			LOG(("API Error: Empty column from stats graph received."));
-			return {};
+			return false;
 		}
-		const auto columnId = array.first().toString();
+		// The DOM based parsing used to read non-strings as empty ids.
+		const auto columnId = reader.readJsonValue().toString();
 		if (columnId == u"x"_q) {
-			const auto length = array.size() - 1;
-			result.x.resize(length);
-			for (auto i = 0; i < length; i++) {
-				result.x[i] = array.at(i + 1).toDouble();
+			result.x.clear();
+			while (!reader.failed() && reader.consume(',')) {
+				result.x.push_back(reader.readNumber());
 			}
 		} else {
 			auto line = Data::StatisticalChart::Line();
-			const auto length = array.size() - 1;
 			line.id = (++columnIdCount);
 			line.idString = columnId;
-			line.isHiddenOnStart = ranges::contains(hiddenLines, columnId);
-			line.y.resize(length);
-			for (auto i = 0; i < length; i++) {
-				const auto value = ChartValue(base::SafeRound(
-					array.at(i + 1).toDouble()));
-				line.y[i] = value;
+			line.y.reserve(result.x.size());
+			while (!reader.failed() && reader.consume(',')) {
+				const auto value = ChartValue(
+					base::SafeRound(reader.readNumber()));
+				line.y.push_back(value);
 				if (value > line.maxValue) {
 					line.maxValue = value;
 				}
@@ -74,14 +277,65 @@ Data::StatisticalChart StatisticalChartFromJSON(const QByteArray &json) {
 			}
 			result.lines.push_back(std::move(line));
 		}
-		if (result.x.size() > 1) {
-			result.timeStep = result.x[1] - result.x[0];
-		} else {
-			constexpr auto kOneDay = 3600 * 24 * 1000;
-			result.timeStep = kOneDay;
-		}
-		result.measure();
+		reader.expect(']');
+	} while (!reader.failed() && reader.consume(','));
+	reader.expect(']');
+	return !reader.failed();
+}
+
+} // namespace
+
+Data::StatisticalChart StatisticalChartFromJSON(const QByteArray &json) {
+	auto result = Data::StatisticalChart();
+	auto reader = Reader(json);
+	auto root = QJsonObject();
+	auto hasColumns = false;
+	reader.expect('{');
+	if (!reader.consume('}')) {
+		do {
+			const auto key = reader.readString();
+			reader.expect(':');
+			if (reader.failed()) {
+				break;
+			} else if (key == u"columns"_q) {
+				if (!ReadColumns(reader, result)) {
+					if (reader.failed()) {
+						break;
+					}
+					return {};
+				}
+				hasColumns = true;
+			} else {
+				root.insert(key, reader.readJsonValue());
+			}
+		} while (!reader.failed() && reader.consume(','));
+		reader.expect('}');
+	}
+	if (reader.failed() || !reader.atEnd()) {
+		LOG(("API Error: Bad stats graph json received."));
+		return {};
+	} else if (!hasColumns) {
+		LOG(("API Error: Empty columns list from stats graph received."));
+		return {};
+	}
+
+	const auto hiddenLinesRaw = root.value(u"hidden"_q).toArray();
+	const auto hiddenLines = ranges::views::all(
+		hiddenLinesRaw
+	) | ranges::views::transform([](const auto &q) {
+		return q.toString();
+	}) | ranges::to_vector;
+	for (auto &line : result.lines) {
+		line.isHiddenOnStart = ranges::contains(hiddenLines, line.idString);
+	}
+
+	if (result.x.size() > 1) {
+		result.timeStep = result.x[1] - result.x[0];
+	} else {
+		constexpr auto kOneDay = 3600 * 24 * 1000;
+		result.timeStep = kOneDay;
 	}
+	result.measure();
 	if (result.maxValue == result.minValue) {
 		if (result.minValue) {
 			result.minValue = 0;
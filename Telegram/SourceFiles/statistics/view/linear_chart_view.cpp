@@ -35,6 +35,40 @@ void PaintChartLine(
 
 	const auto ratio = ratios.ratio(line.id);
 
+	// When zoomed out many points fall into one pixel column.
+	// Keeping only the first, the lowest, the highest and the last
+	// point of each column draws the same polyline with the number
+	// of points bounded by the width instead of the visible range.
+	const auto pixelRatio = style::DevicePixelRatio();
+	chartPoints.reserve(std::min(
+		localEnd - localStart + 1,
+		4 * c.rect.width() * pixelRatio + 4));
+	auto column = std::numeric_limits<int>::min();
+	auto first = QPointF();
+	auto top = QPointF();
+	auto bottom = QPointF();
+	auto last = QPointF();
+	auto count = 0;
+	const auto flush = [&] {
+		if (!count) {
+			return;
+		}
+		chartPoints << first;
+		if (count > 2) {
+			const auto topFirst = (top.x() <= bottom.x());
+			const auto &a = topFirst ? top : bottom;
+			const auto &b = topFirst ? bottom : top;
+			if (a != first && a != last) {
+				chartPoints << a;
+			}
+			if (b != first && b != a && b != last) {
+				chartPoints << b;
+			}
+		}
+		if (count > 1) {
+			chartPoints << last;
+		}
+	};
 	for (auto i = localStart; i <= localEnd; i++) {
 		if (line.y[i] < 0) {
 			continue;
@@ -45,8 +79,25 @@ void PaintChartLine(
 		const auto yPercentage = (line.y[i] * ratio - c.heightLimits.min)
 			/ float64(c.heightLimits.max - c.heightLimits.min);
 		const auto yPoint = (1. - yPercentage) * c.rect.height();
-		chartPoints << QPointF(xPoint, yPoint);
+		const auto point = QPointF(xPoint, yPoint);
+		const auto pointColumn = int(std::floor(xPoint * pixelRatio));
+		if (pointColumn != column) {
+			flush();
+			column = pointColumn;
+			first = top = bottom = last = point;
+			count = 1;
+			continue;
+		}
+		if (yPoint < top.y()) {
+			top = point;
+		}
+		if (yPoint > bottom.y()) {
+			bottom = point;
+		}
+		last = point;
+		++count;
 	}
+	flush();
 	p.setPen(QPen(
 		line.color,
 		c.footer ? st::lineWidth : st::statisticsChartLineWidth));
@@ -471,10 +471,12 @@ void FileWriteDescriptor::finish() {
 	return encrypted;
 }
 
-bool ReadFile(
-		FileReadDescriptor &result,
+namespace {
+
+bool ReadFileWith(
 		const QString &name,
-		const QString &basePath) {
+		const QString &basePath,
+		FnMut<bool(int32 version, bytes::const_span data)> handler) {
 	const auto base = basePath + name;
 
 	// detect order of read attempts
@@ -513,13 +515,26 @@ bool ReadFile(
 			continue;
 		}
 
+		// Map the file instead of reading it, so that the (possibly large)
+		// contents are not copied before the signature check and decrypt.
+		const auto size = f.size();
+		auto bytes = QByteArray();
+		auto all = bytes::const_span();
+		if (const auto mapped = f.map(0, size)) {
+			all = bytes::make_span(mapped, size);
+		} else {
+			bytes = f.readAll();
+			all = bytes::make_span(bytes);
+		}
+		const auto headerSize = TdfMagicLen + int(sizeof(qint32));
+
 		// check magic
-		char magic[TdfMagicLen];
-		if (f.read(magic, TdfMagicLen) != TdfMagicLen) {
+		if (all.size() < TdfMagicLen) {
 			DEBUG_LOG(("App Info: failed to read magic from '%1'"
 				).arg(name));
 			continue;
 		}
+		const auto magic = all.data();
 		if (memcmp(magic, TdfMagic, TdfMagicLen)) {
 			DEBUG_LOG(("App Info: bad magic %1 in '%2'").arg(
 				Logs::mb(magic, TdfMagicLen).str(),
@@ -529,11 +544,12 @@ bool ReadFile(
 
 		// read app version
 		qint32 version;
-		if (f.read((char*)&version, sizeof(version)) != sizeof(version)) {
+		if (all.size() < headerSize) {
 			DEBUG_LOG(("App Info: failed to read version from '%1'"
 				).arg(name));
 			continue;
 		}
+		memcpy(&version, all.data() + TdfMagicLen, sizeof(version));
 		if (version > AppVersion) {
 			DEBUG_LOG(("App Info: version too big %1 for '%2', my version %3"
 				).arg(version
@@ -543,8 +559,8 @@ bool ReadFile(
 		}
 
 		// read data
-		QByteArray bytes = f.read(f.size());
-		int32 dataSize = bytes.size() - 16;
+		const auto data = all.subspan(headerSize);
+		int32 dataSize = int32(data.size()) - 16;
 		if (dataSize < 0) {
 			DEBUG_LOG(("App Info: bad file '%1', could not read sign part"
 				).arg(name));
@@ -553,26 +569,21 @@ bool ReadFile(
 
 		// check signature
 		HashMd5 md5;
-		md5.feed(bytes.constData(), dataSize);
+		md5.feed(data.data(), dataSize);
 		md5.feed(&dataSize, sizeof(dataSize));
 		md5.feed(&version, sizeof(version));
 		md5.feed(magic, TdfMagicLen);
-		if (memcmp(md5.result(), bytes.constData() + dataSize, 16)) {
+		if (memcmp(md5.result(), data.data() + dataSize, 16)) {
 			DEBUG_LOG(("App Info: bad file '%1', signature did not match"
 				).arg(name));
 			continue;
 		}
 
-		bytes.resize(dataSize);
-		result.data = bytes;
-		bytes = QByteArray();
-
-		result.version = version;
-		result.buffer.setBuffer(&result.data);
-		result.buffer.open(QIODevice::ReadOnly);
-		result.stream.setDevice(&result.buffer);
-		result.stream.setVersion(QDataStream::Qt_5_1);
+		if (!handler(version, data.subspan(0, dataSize))) {
+			return false;
+		}
 
+		f.close();
 		if ((i == 0 && !toTry[1].isEmpty()) || i == 1) {
 			QFile::remove(toTry[1 - i]);
 		}
@@ -582,6 +593,27 @@ bool ReadFile(
 	return false;
 }
 
+} // namespace
+
+bool ReadFile(
+		FileReadDescriptor &result,
+		const QString &name,
+		const QString &basePath) {
+	return ReadFileWith(name, basePath, [&](
+			int32 version,
+			bytes::const_span data) {
+		result.data = QByteArray(
+			reinterpret_cast<const char*>(data.data()),
+			data.size());
+		result.version = version;
+		result.buffer.setBuffer(&result.data);
+		result.buffer.open(QIODevice::ReadOnly);
+		result.stream.setDevice(&result.buffer);
+		result.stream.setVersion(QDataStream::Qt_5_1);
+		return true;
+	});
+}
+
 bool DecryptLocal(
 		EncryptedDescriptor &result,
 		const QByteArray &encrypted,
@@ -626,35 +658,39 @@ bool ReadEncryptedFile(
 		const QString &name,
 		const QString &basePath,
 		const MTP::AuthKeyPtr &key) {
-	if (!ReadFile(result, name, basePath)) {
-		return false;
-	}
-	QByteArray encrypted;
-	result.stream >> encrypted;
-
-	EncryptedDescriptor data;
-	if (!DecryptLocal(data, encrypted, key)) {
-		result.stream.setDevice(nullptr);
-		if (result.buffer.isOpen()) result.buffer.close();
-		result.buffer.setBuffer(nullptr);
-		result.data = QByteArray();
-		result.version = 0;
-		return false;
-	}
+	return ReadFileWith(name, basePath, [&](
+			int32 version,
+			bytes::const_span data) {
+		// The file contains one serialized QByteArray: big-endian length
+		// and the encrypted bytes. Decrypt them right from the file data.
+		if (data.size() < sizeof(quint32)) {
+			return false;
+		}
+		const auto length = qFromBigEndian<quint32>(data.data());
+		const auto encrypted = data.subspan(sizeof(quint32));
+		if (length == quint32(0xFFFFFFFF) || length > encrypted.size()) {
+			return false;
+		}
 
-	result.stream.setDevice(0);
-	if (result.buffer.isOpen()) {
-		result.buffer.close();
-	}
-	result.buffer.setBuffer(0);
-	result.data = data.data;
-	result.buffer.setBuffer(&result.data);
-	result.buffer.open(QIODevice::ReadOnly);
-	result.buffer.seek(data.buffer.pos());
-	result.stream.setDevice(&result.buffer);
-	result.stream.setVersion(QDataStream::Qt_5_1);
+		EncryptedDescriptor decrypted;
+		if (!DecryptLocal(
+				decrypted,
+				QByteArray::fromRawData(
+					reinterpret_cast<const char*>(encrypted.data()),
+					length),
+				key)) {
+			return false;
+		}
 
-	return true;
+		result.version = version;
+		result.data = decrypted.data;
+		result.buffer.setBuffer(&result.data);
+		result.buffer.open(QIODevice::ReadOnly);
+		result.buffer.seek(decrypted.buffer.pos());
+		result.stream.setDevice(&result.buffer);
+		result.stream.setVersion(QDataStream::Qt_5_1);
+		return true;
+	});
 }
 
 bool ReadEncryptedFile(
@@ -63,12 +63,60 @@ constexpr auto kSlowRequestThreshold = 8 * crl::time(1000);
 // (it-s size + queued before size) >= 512kb.
 constexpr auto kAcceptAsFastIfTotalAtLeast = 512 * 1024;
 
+// Up to 2mb of document parts are read from disk before being sent.
+constexpr auto kDocumentReadAheadSize = 2 * 1024 * 1024;
+constexpr auto kDocumentReadAheadPartsMin = 2;
+constexpr auto kDocumentReadAheadPartsMax = 16;
+
 [[nodiscard]] const char *ThumbnailFormat(const QString &mime) {
 	return Core::IsMimeSticker(mime) ? "WEBP" : "JPG";
 }
 
 } // namespace
 
+// Reads document parts from disk on a background thread, feeding md5 hash
+// in the reading order, so that the main thread only takes ready buffers.
+struct Uploader::DocPartsReader {
+	DocPartsReader(
+		QString filepath,
+		int partSize,
+		ushort partsCount,
+		bool hashMd5);
+
+	static void Read(
+		const std::weak_ptr<DocPartsReader> &weak,
+		Fn<void()> notify);
+
+	// Returns std::nullopt if the next part was not read yet
+	// and an empty QByteArray if reading has failed.
+	[[nodiscard]] std::optional<QByteArray> take();
+
+	// Returns true if a new reading job should be started.
+	[[nodiscard]] bool startReading();
+
+	const QString filepath;
+	const int partSize = 0;
+	const int readAheadParts = 0;
+	const ushort partsCount = 0;
+	const bool hashMd5 = false;
+
+	// Accessed only from the reading thread until all parts are read.
+	std::unique_ptr<QFile> file;
+	HashMd5 md5Hash;
+
+	QMutex mutex;
+	std::deque<QByteArray> ready;
+	int64 readBytes = 0;
+	crl::time readDuration = 0;
+	ushort partsRead = 0;
+	bool reading = false;
+	bool failed = false;
+
+private:
+	[[nodiscard]] bool readNext();
+
+};
+
 struct Uploader::Entry {
 	Entry(FullMsgId itemId, const std::shared_ptr<FilePrepareResult> &file);
 
@@ -87,7 +135,8 @@ struct Uploader::Entry {
 
 	HashMd5 md5Hash;
 
-	std::unique_ptr<QFile> docFile;
+	std::shared_ptr<DocPartsReader> docPartsReader;
+	crl::time docSendStarted = 0;
 	int64 docSize = 0;
 	int64 docSentSize = 0;
 	int docPartSize = 0;
@@ -109,6 +158,102 @@ struct Uploader::Request {
 	bool nonPremiumDelayed = false;
 };
 
+Uploader::DocPartsReader::DocPartsReader(
+	QString filepath,
+	int partSize,
+	ushort partsCount,
+	bool hashMd5)
+: filepath(std::move(filepath))
+, partSize(partSize)
+, readAheadParts(std::clamp(
+	kDocumentReadAheadSize / partSize,
+	kDocumentReadAheadPartsMin,
+	kDocumentReadAheadPartsMax))
+, partsCount(partsCount)
+, hashMd5(hashMd5) {
+	Expects(partSize > 0);
+}
+
+void Uploader::DocPartsReader::Read(
+		const std::weak_ptr<DocPartsReader> &weak,
+		Fn<void()> notify) {
+	while (const auto strong = weak.lock()) {
+		if (!strong->readNext()) {
+			break;
+		}
+		notify();
+	}
+}
+
+bool Uploader::DocPartsReader::readNext() {
+	auto index = ushort();
+	{
+		QMutexLocker lock(&mutex);
+		if (failed
+			|| partsRead >= partsCount
+			|| int(ready.size()) >= readAheadParts) {
+			reading = false;
+			return false;
+		}
+		index = partsRead;
+	}
+	const auto started = crl::now();
+	const auto fail = [&] {
+		QMutexLocker lock(&mutex);
+		failed = true;
+		reading = false;
+		return true;
+	};
+	if (!file) {
+		file = std::make_unique<QFile>(filepath);
+		if (!file->open(QIODevice::ReadOnly)) {
+			return fail();
+		}
+	}
+	auto bytes = file->read(partSize);
+	if (bytes.isEmpty()
+		|| (bytes.size() > partSize)
+		|| (bytes.size() < partSize && index + 1 != partsCount)) {
+		return fail();
+	} else if (hashMd5) {
+		md5Hash.feed(bytes.data(), bytes.size());
+	}
+	if (index + 1 == partsCount) {
+		file = nullptr;
+	}
+
+	QMutexLocker lock(&mutex);
+	readBytes += bytes.size();
+	readDuration += crl::now() - started;
+	ready.push_back(std::move(bytes));
+	++partsRead;
+	return true;
+}
+
+std::optional<QByteArray> Uploader::DocPartsReader::take() {
+	QMutexLocker lock(&mutex);
+	if (!ready.empty()) {
+		auto result = std::move(ready.front());
+		ready.pop_front();
+		return result;
+	} else if (failed) {
+		return QByteArray();
+	}
+	return std::nullopt;
+}
+
+bool Uploader::DocPartsReader::startReading() {
+	QMutexLocker lock(&mutex);
+	if (reading
+		|| failed
+		|| partsRead >= partsCount
+		|| int(ready.size()) >= readAheadParts) {
+		return false;
+	}
+	reading = true;
+	return true;
+}
+
 Uploader::Entry::Entry(
 	FullMsgId itemId,
 	const std::shared_ptr<FilePrepareResult> &file)
@@ -381,12 +526,13 @@ void Uploader::stopSessions() {
 	}
 }
 
-QByteArray Uploader::readDocPart(not_null<Entry*> entry) {
+std::optional<QByteArray> Uploader::readDocPart(not_null<Entry*> entry) {
+	const auto hashMd5 = (entry->file->type == SendMediaType::File
+		|| entry->file->type == SendMediaType::ThemeFile
+		|| entry->file->type == SendMediaType::Audio)
+		&& (entry->docSize <= kUseBigFilesFrom);
 	const auto checked = [&](QByteArray result) {
-		if ((entry->file->type == SendMediaType::File
-			|| entry->file->type == SendMediaType::ThemeFile
-			|| entry->file->type == SendMediaType::Audio)
-			&& entry->docSize <= kUseBigFilesFrom) {
+		if (hashMd5) {
 			entry->md5Hash.feed(result.data(), result.size());
 		}
 		if (result.isEmpty()
@@ -401,14 +547,53 @@ QByteArray Uploader::readDocPart(not_null<Entry*> entry) {
 	if (!content.isEmpty()) {
 		const auto offset = entry->docPartsSent * entry->docPartSize;
 		return checked(content.mid(offset, entry->docPartSize));
-	} else if (!entry->docFile) {
-		const auto filepath = entry->file->filepath;
-		entry->docFile = std::make_unique<QFile>(filepath);
-		if (!entry->docFile->open(QIODevice::ReadOnly)) {
-			return QByteArray();
-		}
+	} else if (!entry->docPartsReader) {
+		entry->docPartsReader = std::make_shared<DocPartsReader>(
+			entry->file->filepath,
+			entry->docPartSize,
+			entry->docPartsCount,
+			hashMd5);
 	}
-	return checked(entry->docFile->read(entry->docPartSize));
+	auto result = entry->docPartsReader->take();
+	startDocPartsReading(entry);
+	return result;
+}
+
+void Uploader::startDocPartsReading(not_null<Entry*> entry) {
+	Expects(entry->docPartsReader != nullptr);
+
+	if (!entry->docPartsReader->startReading()) {
+		return;
+	}
+	const auto weak = std::weak_ptr<DocPartsReader>(entry->docPartsReader);
+	crl::async([=, guard = base::make_weak(this)] {
+		DocPartsReader::Read(weak, [=] {
+			crl::on_main(guard, [=] {
+				maybeSend();
+			});
+		});
+	});
+}
+
+auto Uploader::uploadStats(FullMsgId itemId) const
+-> std::optional<UploadStats> {
+	const auto i = ranges::find(_queue, itemId, &Entry::itemId);
+	if (i == end(_queue)) {
+		return std::nullopt;
+	}
+	auto result = UploadStats{
+		.sentBytes = i->sentSize + i->docSentSize,
+		.sendingDuration = (i->docSendStarted
+			? (crl::now() - i->docSendStarted)
+			: crl::time(0)),
+	};
+	if (const auto reader = i->docPartsReader.get()) {
+		QMutexLocker lock(&reader->mutex);
+		result.readBytes = reader->readBytes;
+		result.readDuration = reader->readDuration;
+		result.readAheadParts = int(reader->ready.size());
+	}
+	return result;
 }
 
 bool Uploader::canAddDcIndex() const {
@@ -529,11 +714,18 @@ auto Uploader::sendDocPart(not_null<Entry*> entry, uchar dcIndex)
 
 	Assert(entry->docPartsSent < entry->docPartsCount);
 
-	const auto partBytes = readDocPart(entry);
+	const auto read = readDocPart(entry);
+	if (!read) {
+		return SendResult::NotReady;
+	}
+	const auto partBytes = *read;
 	if (partBytes.isEmpty()) {
 		failed(itemId);
 		return SendResult::Failed;
 	}
+	if (!entry->docSendStarted) {
+		entry->docSendStarted = crl::now();
+	}
 	const auto part = entry->docPartsSent++;
 	++entry->docPartsWaiting;
 
@@ -615,7 +807,9 @@ void Uploader::maybeSend() {
 				return;
 			}
 			const auto result = sendPart(entry, dcIndex);
-			if (result == SendResult::DcIndexFull) {
+			if (result == SendResult::DcIndexFull
+				|| result == SendResult::NotReady) {
+				// Reading more parts will call maybeSend() when ready.
 				return;
 			} else if (result == SendResult::Success) {
 				break;
@@ -857,8 +1051,20 @@ void Uploader::finishFront() {
 	} else if (entry.file->type == SendMediaType::File
 		|| entry.file->type == SendMediaType::ThemeFile
 		|| entry.file->type == SendMediaType::Audio) {
+		auto &md5Hash = entry.docPartsReader
+			? entry.docPartsReader->md5Hash
+			: entry.md5Hash;
 		QByteArray docMd5(32, Qt::Uninitialized);
-		hashMd5Hex(entry.md5Hash.result(), docMd5.data());
+		hashMd5Hex(md5Hash.result(), docMd5.data());
+
+		if (const auto reader = entry.docPartsReader.get()) {
+			DEBUG_LOG(("Uploader: Document read %1 bytes in %2ms, "
+				"sent %3 bytes in %4ms."
+				).arg(reader->readBytes
+				).arg(reader->readDuration
+				).arg(entry.docSentSize
+				).arg(crl::now() - entry.docSendStarted));
+		}
 
 		const auto file = (entry.docSize > kUseBigFilesFrom)
 			? MTP_inputFileBig(
@@ -41,6 +41,15 @@ struct UploadSecureProgress {
 	int64 size = 0;
 };
 
+// Throughput counters of an upload in progress.
+struct UploadStats {
+	int64 readBytes = 0;
+	crl::time readDuration = 0;
+	int64 sentBytes = 0;
+	crl::time sendingDuration = 0;
+	int readAheadParts = 0;
+};
+
 struct UploadSecureDone {
 	FullMsgId fullId;
 	uint64 fileId = 0;
@@ -54,6 +63,8 @@ public:
 
 	[[nodiscard]] Main::Session &session() const;
 	[[nodiscard]] FullMsgId currentUploadId() const;
+	[[nodiscard]] std::optional<UploadStats> uploadStats(
+		FullMsgId itemId) const;
 
 	void upload(
 		FullMsgId itemId,
@@ -100,6 +111,7 @@ public:
 	void stopSessions();
 
 private:
+	struct DocPartsReader;
 	struct Entry;
 	struct Request;
 
@@ -107,6 +119,7 @@ private:
 		Success,
 		Failed,
 		DcIndexFull,
+		NotReady,
 	};
 
 	void maybeSend();
@@ -121,7 +134,9 @@ private:
 		-> SendResult;
 	[[nodiscard]] auto sendSlicedPart(not_null<Entry*> entry, uchar dcIndex)
 		-> SendResult;
-	[[nodiscard]] QByteArray readDocPart(not_null<Entry*> entry);
+	[[nodiscard]] std::optional<QByteArray> readDocPart(
+		not_null<Entry*> entry);
+	void startDocPartsReading(not_null<Entry*> entry);
 	void removeDcIndex();
 
 	template <typename Prepared>
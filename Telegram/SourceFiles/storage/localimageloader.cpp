@@ -222,7 +222,10 @@ int PhotoSideLimit() {
 	return PhotoSideLimit(SendLargePhotos.value());
 }
 
-TaskQueue::TaskQueue(crl::time stopTimeoutMs) {
+TaskQueue::TaskQueue(crl::time stopTimeoutMs, int workersLimit)
+: _workersLimit((workersLimit > 0)
+	? std::min(workersLimit, std::max(QThread::idealThreadCount(), 1))
+	: std::max(QThread::idealThreadCount(), 1)) {
 	if (stopTimeoutMs > 0) {
 		_stopTimer = new QTimer(this);
 		connect(_stopTimer, SIGNAL(timeout()), this, SLOT(stop()));
@@ -238,7 +241,7 @@ TaskId TaskQueue::addTask(std::unique_ptr<Task> &&task) {
 		_tasksToProcess.push_back(std::move(task));
 	}
 
-	wakeThread();
+	wakeThreads();
 
 	return result;
 }
@@ -251,25 +254,69 @@ void TaskQueue::addTasks(std::vector<std::unique_ptr<Task>> &&tasks) {
 		}
 	}
 
-	wakeThread();
+	wakeThreads();
 }
 
-void TaskQueue::wakeThread() {
-	if (!_thread) {
-		_thread = new QThread();
+void TaskQueue::wakeThreads() {
+	const auto required = [&] {
+		QMutexLocker lock(&_tasksToProcessMutex);
+		return std::min(
+			int(_tasksToProcess.size() + _tasksInProcess.size()),
+			_workersLimit);
+	}();
+	while (int(_threads.size()) < std::max(required, 1)) {
+		const auto thread = new QThread();
 
-		_worker = new TaskQueueWorker(this);
-		_worker->moveToThread(_thread);
+		const auto worker = new TaskQueueWorker(this);
+		worker->moveToThread(thread);
 
-		connect(this, SIGNAL(taskAdded()), _worker, SLOT(onTaskAdded()));
-		connect(_worker, SIGNAL(taskProcessed()), this, SLOT(onTaskProcessed()));
+		connect(this, SIGNAL(taskAdded()), worker, SLOT(onTaskAdded()));
+		connect(worker, SIGNAL(taskProcessed()), this, SLOT(onTaskProcessed()));
 
-		_thread->start();
+		thread->start();
+
+		_threads.push_back(thread);
+		_workers.push_back(worker);
 	}
 	if (_stopTimer) _stopTimer->stop();
 	taskAdded();
 }
 
+std::unique_ptr<Task> TaskQueue::takeTaskToProcess() {
+	if (_tasksToProcess.empty()) {
+		return nullptr;
+	}
+	auto result = std::move(_tasksToProcess.front());
+	_tasksToProcess.pop_front();
+	_tasksInProcess.push_back({ .id = result->id() });
+	return result;
+}
+
+bool TaskQueue::taskProcessed(std::unique_ptr<Task> &task) {
+	const auto i = ranges::find(
+		_tasksInProcess,
+		task->id(),
+		&TaskInProcess::id);
+	if (i == end(_tasksInProcess)) {
+		// Cancelled while being processed.
+		return false;
+	}
+	i->processed = std::move(task);
+	return moveProcessedToFinish();
+}
+
+bool TaskQueue::moveProcessedToFinish() {
+	auto emitTaskProcessed = false;
+	QMutexLocker lock(&_tasksToFinishMutex);
+	while (!_tasksInProcess.empty() && _tasksInProcess.front().processed) {
+		emitTaskProcessed = emitTaskProcessed || _tasksToFinish.empty();
+		_tasksToFinish.push_back(
+			std::move(_tasksInProcess.front().processed));
+		_tasksInProcess.pop_front();
+	}
+	return emitTaskProcessed;
+}
+
 void TaskQueue::cancelTask(TaskId id) {
 	const auto removeFrom = [&](std::deque<std::unique_ptr<Task>> &queue) {
 		const auto proj = [](const std::unique_ptr<Task> &task) {
@@ -280,15 +327,31 @@ void TaskQueue::cancelTask(TaskId id) {
 			queue.erase(i);
 		}
 	};
+	auto emitTaskProcessed = false;
 	{
 		QMutexLocker lock(&_tasksToProcessMutex);
 		removeFrom(_tasksToProcess);
-		if (_taskInProcessId == id) {
-			_taskInProcessId = TaskId();
+		const auto i = ranges::find(
+			_tasksInProcess,
+			id,
+			&TaskInProcess::id);
+		if (i != end(_tasksInProcess)) {
+			_tasksInProcess.erase(i);
+
+			// Tasks processed after the cancelled one were waiting for it.
+			emitTaskProcessed = moveProcessedToFinish();
 		}
 	}
-	QMutexLocker lock(&_tasksToFinishMutex);
-	removeFrom(_tasksToFinish);
+	{
+		QMutexLocker lock(&_tasksToFinishMutex);
+		removeFrom(_tasksToFinish);
+	}
+	if (emitTaskProcessed) {
+		QMetaObject::invokeMethod(
+			this,
+			"onTaskProcessed",
+			Qt::QueuedConnection);
+	}
 }
 
 void TaskQueue::onTaskProcessed() {
@@ -305,24 +368,32 @@ void TaskQueue::onTaskProcessed() {
 
 	if (_stopTimer) {
 		QMutexLocker lock(&_tasksToProcessMutex);
-		if (_tasksToProcess.empty() && !_taskInProcessId) {
+		if (_tasksToProcess.empty() && _tasksInProcess.empty()) {
 			_stopTimer->start();
 		}
 	}
 }
 
 void TaskQueue::stop() {
-	if (_thread) {
-		_thread->requestInterruption();
-		_thread->quit();
-		DEBUG_LOG(("Waiting for taskThread to finish"));
-		_thread->wait();
-		delete base::take(_worker);
-		delete base::take(_thread);
+	for (const auto thread : _threads) {
+		thread->requestInterruption();
+		thread->quit();
+	}
+	if (!_threads.empty()) {
+		DEBUG_LOG(("Waiting for taskThreads to finish"));
+	}
+	for (const auto thread : _threads) {
+		thread->wait();
+	}
+	for (const auto worker : base::take(_workers)) {
+		delete worker;
+	}
+	for (const auto thread : base::take(_threads)) {
+		delete thread;
 	}
 	_tasksToProcess.clear();
+	_tasksInProcess.clear();
 	_tasksToFinish.clear();
-	_taskInProcessId = TaskId();
 }
 
 TaskQueue::~TaskQueue() {
@@ -339,26 +410,17 @@ void TaskQueueWorker::onTaskAdded() {
 		auto task = std::unique_ptr<Task>();
 		{
 			QMutexLocker lock(&_queue->_tasksToProcessMutex);
-			if (!_queue->_tasksToProcess.empty()) {
-				task = std::move(_queue->_tasksToProcess.front());
-				_queue->_tasksToProcess.pop_front();
-				_queue->_taskInProcessId = task->id();
-			}
+			task = _queue->takeTaskToProcess();
 		}
 
+		someTasksLeft = false;
 		if (task) {
 			task->process();
 			bool emitTaskProcessed = false;
 			{
-				QMutexLocker lockToProcess(&_queue->_tasksToProcessMutex);
-				if (_queue->_taskInProcessId == task->id()) {
-					_queue->_taskInProcessId = TaskId();
-					someTasksLeft = !_queue->_tasksToProcess.empty();
-
-					QMutexLocker lockToFinish(&_queue->_tasksToFinishMutex);
-					emitTaskProcessed = _queue->_tasksToFinish.empty();
-					_queue->_tasksToFinish.push_back(std::move(task));
-				}
+				QMutexLocker lock(&_queue->_tasksToProcessMutex);
+				emitTaskProcessed = _queue->taskProcessed(task);
+				someTasksLeft = !_queue->_tasksToProcess.empty();
 			}
 			if (emitTaskProcessed) {
 				taskProcessed();
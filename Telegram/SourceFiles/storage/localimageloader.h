@@ -56,7 +56,9 @@ class TaskQueue : public QObject {
 	Q_OBJECT
 
 public:
-	explicit TaskQueue(crl::time stopTimeoutMs = 0); // <= 0 - never stop worker
+	explicit TaskQueue(
+		crl::time stopTimeoutMs = 0, // <= 0 - never stop workers
+		int workersLimit = 1); // <= 0 - one worker per core
 
 	TaskId addTask(std::unique_ptr<Task> &&task);
 	void addTasks(std::vector<std::unique_ptr<Task>> &&tasks);
@@ -74,14 +76,27 @@ public Q_SLOTS:
 private:
 	friend class TaskQueueWorker;
 
-	void wakeThread();
+	struct TaskInProcess {
+		TaskId id = kEmptyTaskId;
+		std::unique_ptr<Task> processed;
+	};
+
+	void wakeThreads();
+
+	// All must be called with _tasksToProcessMutex locked.
+	[[nodiscard]] std::unique_ptr<Task> takeTaskToProcess();
+	[[nodiscard]] bool taskProcessed(std::unique_ptr<Task> &task);
+	[[nodiscard]] bool moveProcessedToFinish();
 
+	// Tasks are processed in parallel, but finished in the order they were
+	// added, so that album items and consequent sends keep their order.
 	std::deque<std::unique_ptr<Task>> _tasksToProcess;
+	std::deque<TaskInProcess> _tasksInProcess;
 	std::deque<std::unique_ptr<Task>> _tasksToFinish;
-	TaskId _taskInProcessId = TaskId();
 	QMutex _tasksToProcessMutex, _tasksToFinishMutex;
-	QThread *_thread = nullptr;
-	TaskQueueWorker *_worker = nullptr;
+	std::vector<QThread*> _threads;
+	std::vector<TaskQueueWorker*> _workers;
+	int _workersLimit = 1;
 	QTimer *_stopTimer = nullptr;
 
 };
@@ -8,6 +8,31 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "storage/storage_sparse_ids_list.h"
 
 namespace Storage {
+namespace {
+
+template <typename Range>
+[[nodiscard]] std::vector<MsgId> SortedIds(const Range &messages) {
+	auto result = std::vector<MsgId>(
+		std::begin(messages),
+		std::end(messages));
+	if (!ranges::is_sorted(result)) {
+		ranges::sort(result);
+	}
+	return result;
+}
+
+// The base::flat_set range constructor sorts the ids once again,
+// while emplacing already sorted unique ids in order only appends.
+[[nodiscard]] base::flat_set<MsgId> FromSortedUnique(
+		const std::vector<MsgId> &ids) {
+	auto result = base::flat_set<MsgId>();
+	for (const auto id : ids) {
+		result.emplace(id);
+	}
+	return result;
+}
+
+} // namespace
 
 SparseIdsList::Slice::Slice(
 	base::flat_set<MsgId> &&messages,
@@ -23,7 +48,30 @@ void SparseIdsList::Slice::merge(
 	Expects(moreNoSkipRange.from <= range.till);
 	Expects(range.from <= moreNoSkipRange.till);
 
-	messages.merge(std::begin(moreMessages), std::end(moreMessages));
+	const auto from = std::begin(moreMessages);
+	const auto till = std::end(moreMessages);
+	const auto appending = messages.empty()
+		|| std::all_of(from, till, [last = messages.back()](MsgId id) {
+			return id > last;
+		});
+	if (appending) {
+		// The most common case: new messages or next loaded pages,
+		// those are inserted near the end without touching the rest.
+		for (auto i = from; i != till; ++i) {
+			messages.emplace(*i);
+		}
+	} else {
+		const auto sorted = SortedIds(moreMessages);
+		auto united = std::vector<MsgId>();
+		united.reserve(messages.size() + sorted.size());
+		std::set_union(
+			messages.begin(),
+			messages.end(),
+			sorted.begin(),
+			sorted.end(),
+			std::back_inserter(united));
+		messages = FromSortedUnique(united);
+	}
 	range = {
 		qMin(range.from, moreNoSkipRange.from),
 		qMax(range.till, moreNoSkipRange.till)
@@ -39,16 +87,43 @@ SparseIdsList::AddResult SparseIdsList::uniteAndAdd(
 		MsgRange noSkipRange) {
 	const auto uniteFromIndex = uniteFrom - _slices.begin();
 	const auto was = int(uniteFrom->messages.size());
-	_slices.modify(uniteFrom, [&](Slice &slice) {
-		slice.merge(messages, noSkipRange);
-	});
 	const auto firstToErase = uniteFrom + 1;
-	if (firstToErase != uniteTill) {
-		for (auto it = firstToErase; it != uniteTill; ++it) {
-			_slices.modify(uniteFrom, [&](Slice &slice) {
-				slice.merge(it->messages, it->range);
-			});
+	if (firstToErase == uniteTill) {
+		_slices.modify(uniteFrom, [&](Slice &slice) {
+			slice.merge(messages, noSkipRange);
+		});
+	} else {
+		// Slices are sorted and don't intersect, so we can concatenate
+		// them and unite with the new messages in a single pass,
+		// instead of merging them one by one into the first slice.
+		auto concatenated = std::vector<MsgId>();
+		auto size = std::size_t(0);
+		for (auto it = uniteFrom; it != uniteTill; ++it) {
+			size += it->messages.size();
 		}
+		concatenated.reserve(size);
+		auto united = noSkipRange;
+		for (auto it = uniteFrom; it != uniteTill; ++it) {
+			concatenated.insert(
+				concatenated.end(),
+				it->messages.begin(),
+				it->messages.end());
+			united.from = qMin(united.from, it->range.from);
+			united.till = qMax(united.till, it->range.till);
+		}
+		const auto sorted = SortedIds(messages);
+		auto result = std::vector<MsgId>();
+		result.reserve(concatenated.size() + sorted.size());
+		std::set_union(
+			concatenated.begin(),
+			concatenated.end(),
+			sorted.begin(),
+			sorted.end(),
+			std::back_inserter(result));
+		_slices.modify(uniteFrom, [&](Slice &slice) {
+			slice.messages = FromSortedUnique(result);
+			slice.range = united;
+		});
 		_slices.erase(firstToErase, uniteTill);
 		uniteFrom = _slices.begin() + uniteFromIndex;
 	}
@@ -238,8 +313,9 @@ SparseIdsListResult SparseIdsList::queryFromSlice(
 	auto haveEqualOrAfter = int(slice.messages.end() - position);
 	auto before = qMin(haveBefore, query.limitBefore);
 	auto equalOrAfter = qMin(haveEqualOrAfter, query.limitAfter + 1);
-	auto ids = std::vector<MsgId>(position - before, position + equalOrAfter);
-	result.messageIds.merge(ids.begin(), ids.end());
+	result.messageIds = base::flat_set<MsgId>(
+		position - before,
+		position + equalOrAfter);
 	if (slice.range.from == 0) {
 		result.skippedBefore = haveBefore - before;
 	}
@@ -56,7 +56,7 @@ namespace {
 [[nodiscard]] rpl::producer<Dialogs::UnreadState> MainListUnreadState(
 		not_null<Dialogs::MainList*> list) {
 	return rpl::single(rpl::empty) | rpl::then(
-		list->unreadStateChanges() | rpl::to_empty
+		list->unreadStateChangesBatched()
 	) | rpl::map([=] {
 		return list->unreadState();
 	});
@@ -620,8 +620,8 @@ void MainMenu::setupArchive() {
 	Badge::AddUnread(button, rpl::single(rpl::empty) | rpl::then(std::move(
 		folderValue
 	) | rpl::map([=](not_null<Data::Folder*> folder) {
-		return folder->owner().chatsList(folder)->unreadStateChanges();
-	}) | rpl::flatten_latest() | rpl::to_empty) | rpl::map([=] {
+		return folder->owner().chatsList(folder)->unreadStateChangesBatched();
+	}) | rpl::flatten_latest()) | rpl::map([=] {
 		const auto loaded = folder();
 		const auto state = loaded
 			? loaded->chatListBadgesState()